@@ -2179,6 +2179,16 @@ class PAG_API File {
    */
   static std::shared_ptr<File> Load(const std::string& filePath);
 
+  /**
+   * Sets the maximum total size in bytes of the recently loaded files which are kept alive after
+   * being released, so that loading them again by the same path or the same content skips the
+   * decoding. Files loaded by path are always reused while they are still alive regardless of
+   * this value. Files loaded without a path are matched by content only when this value is greater
+   * than 0, and a copy of their bytes is kept for verification and counted in this size. The
+   * default value is 0.
+   */
+  static void SetMaxCacheSize(size_t bytes);
+
   ~File();
 
   /**
@@ -2331,11 +2341,30 @@ class PAG_API Codec {
   static std::unique_ptr<ByteData> Encode(std::shared_ptr<File> pagFile,
                                           std::shared_ptr<PerformanceData> performanceData);
 
+  /**
+   * Encode a pag file with the corresponding performance data to byte data, return null if the file
+   * is null. If compressed is true, every top-level tag is compressed independently with zlib,
+   * which usually makes vector-heavy files several times smaller. Note that compressed files can
+   * not be decoded by the SDKs earlier than this version. If tagIndexEnabled is true, an index of
+   * the top-level tags is appended to the end of the file, which allows ReadPerformanceData() and
+   * ReadFileAttributes() to jump to the tag directly. The index is ignored by earlier SDKs.
+   */
+  static std::unique_ptr<ByteData> Encode(std::shared_ptr<File> pagFile,
+                                          std::shared_ptr<PerformanceData> performanceData,
+                                          bool compressed, bool tagIndexEnabled = false);
+
   /**
    * Read the performance data from the specified byte data, return null if the byte data contains
    * no performance data.
    */
   static std::shared_ptr<PerformanceData> ReadPerformanceData(const void* bytes,
                                                               uint32_t byteLength);
+
+  /**
+   * Read the file attributes from the specified byte data without decoding the whole file, return
+   * null if the byte data contains no file attributes.
+   */
+  static std::shared_ptr<FileAttributes> ReadFileAttributes(const void* bytes,
+                                                            uint32_t byteLength);
 };
 }  // namespace pag
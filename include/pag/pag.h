@@ -1021,6 +1021,13 @@ class PAG_API PAGFile : public PAGComposition {
    */
   static std::shared_ptr<PAGFile> Load(const std::string& filePath);
 
+  /**
+   * Sets the maximum total size in bytes of the recently loaded files which are kept alive after
+   * being released, so that loading them again by the same path or the same content skips the
+   * decoding. The default value is 0.
+   */
+  static void SetMaxCacheSize(size_t bytes);
+
   PAGFile(std::shared_ptr<File> file, PreComposeLayer* layer);
 
   /**
@@ -1175,6 +1182,23 @@ class PAG_API PAGSurface {
    */
   static std::shared_ptr<PAGSurface> MakeOffscreen(int width, int height);
 
+  /**
+   * Creates a new PAGSurface for off-screen rendering. If useSharedDevice is true, the returned
+   * PAGSurface shares a GPU device with other off-screen PAGSurfaces which are also created with
+   * useSharedDevice set to true. The shared devices are picked from a small global pool, so the
+   * GPU context creation and shader compilation are not paid again for every PAGSurface. This is
+   * useful when creating many short-lived off-screen PAGSurfaces. Note that the PAGSurfaces
+   * sharing one device can not render concurrently. Returns null if the specified size is not
+   * valid.
+   */
+  static std::shared_ptr<PAGSurface> MakeOffscreen(int width, int height, bool useSharedDevice);
+
+  /**
+   * Sets the maximum number of GPU devices that can be shared by off-screen PAGSurfaces. The
+   * default value is 2.
+   */
+  static void SetMaxSharedDeviceCount(int count);
+
   /**
    * Returns the width in pixels of the surface.
    */
@@ -1221,6 +1245,7 @@ class PAG_API PAGSurface {
   bool draw(RenderCache* cache, std::shared_ptr<Graphic> graphic, BackendSemaphore* signalSemaphore,
             bool autoClear = true);
   bool hitTest(RenderCache* cache, std::shared_ptr<Graphic> graphic, float x, float y);
+  bool warmUp(RenderCache* cache, PAGLayer* pagLayer);
   tgfx::Context* lockContext();
   void unlockContext();
   bool wait(const BackendSemaphore& waitSemaphore);
@@ -1376,6 +1401,14 @@ class PAG_API PAGPlayer {
    */
   void prepare();
 
+  /**
+   * Compiles the GPU programs of all effects, layer styles and motion blurs used by the current
+   * composition ahead of time, so that the first frames using them do not pay the compiling costs.
+   * It should be called after a surface is set and before playing a new composition. Returns false
+   * if there is no surface or the GPU context is unavailable.
+   */
+  bool warmUp();
+
   /**
    * Inserts a GPU semaphore that the current GPU-backed API must wait on before executing any more
    * commands on the GPU for this player. It is usually called before PAGPlayer.flush(). PAG will
@@ -1459,6 +1492,13 @@ class PAG_API PAGPlayer {
    */
   int64_t graphicsMemory();
 
+  /**
+   * The graphics memory in bytes predicted for the current frame, which can be compared with
+   * graphicsMemory() to check the accuracy of the prediction. Returns 0 if the current composition
+   * is not a PAGFile.
+   */
+  int64_t predictedGraphicsMemory();
+
  protected:
   std::shared_ptr<std::mutex> rootLocker = nullptr;
   std::shared_ptr<PAGStage> stage = nullptr;
@@ -1495,6 +1535,14 @@ class PAG_API PAGVideoDecoder {
    */
   static void SetMaxHardwareDecoderCount(int count);
 
+  /**
+   * Set the number of threads the built-in software video decoder can use to decode one frame. The
+   * built-in decoder uses up to 3 threads. The default value is 0, which means the number of
+   * threads is determined by the CPU cores of current device. Only affects the decoders created
+   * after this call.
+   */
+  static void SetSoftwareDecoderThreadCount(int count);
+
   /**
    * Register a software decoder factory to PAG, which can be used to create video decoders for
    * decoding video sequences from a pag file, if hardware decoders are not available.
@@ -1502,6 +1550,36 @@ class PAG_API PAGVideoDecoder {
   static void RegisterSoftwareDecoderFactory(SoftwareDecoderFactory* decoderFactory);
 };
 
+/**
+ * PAGTrace records the time spent on creating layer contents, applying filters, tessellating
+ * paths, building text atlases, decoding images and videos, uploading textures and flushing the
+ * GPU, and exports them in the Chrome trace-event format.
+ */
+class PAG_API PAGTrace {
+ public:
+  /**
+   * Enables or disables tracing. Tracing is disabled by default.
+   */
+  static void SetEnabled(bool enabled);
+
+  /**
+   * Returns true if tracing is enabled.
+   */
+  static bool IsEnabled();
+
+  /**
+   * Returns the recorded spans as a JSON string in the Chrome trace-event format, which can be
+   * loaded by chrome://tracing or https://ui.perfetto.dev. Each thread keeps its 4096 most recent
+   * spans.
+   */
+  static std::string ExportJSON();
+
+  /**
+   * Removes all the recorded spans.
+   */
+  static void Clear();
+};
+
 class PAG_API PAG {
  public:
   /**
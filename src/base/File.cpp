@@ -18,6 +18,8 @@
 
 #include "pag/file.h"
 #include <algorithm>
+#include <cstring>
+#include <list>
 #include <unordered_map>
 
 namespace pag {
@@ -26,6 +28,151 @@ static std::mutex globalLocker = {};
 static std::unordered_map<std::string, std::weak_ptr<File>> weakFileMap =
     std::unordered_map<std::string, std::weak_ptr<File>>();
 
+struct RecentFile {
+  std::shared_ptr<File> file = nullptr;
+  size_t size = 0;
+  // 没有路径时按内容缓存，保留一份原始数据用于在命中时逐字节校验，大小计入 size。
+  std::string contentKey = "";
+  std::unique_ptr<ByteData> bytes = nullptr;
+};
+// 最近加载的文件，在 maxCacheSize 的范围内保持强引用，释放后再次加载可以跳过解码。
+static std::list<RecentFile> recentFiles = {};
+static size_t recentFilesSize = 0;
+static size_t maxCacheSize = 0;
+
+// 按内容索引所有已加载文件中的图片，内容相同的 ImageBytes 共用一个 uniqueID 和同一份文件数据，
+// 渲染时只需解码上传一次。文件数据由各个 ImageBytes 通过引用计数共同持有，与所属文件的生命周期
+// 无关。
+struct SharedImage {
+  ID uniqueID = 0;
+  std::weak_ptr<ByteData> payload = {};
+};
+static std::unordered_map<std::string, SharedImage> sharedImageMap = {};
+
+static uint64_t HashBytes(const void* bytes, size_t length) {
+  // 按 8 字节分组的 FNV-1a 变体，只用于分桶，命中后仍需逐字节校验。
+  auto data = static_cast<const uint8_t*>(bytes);
+  uint64_t hash = 14695981039346656037ULL;
+  size_t index = 0;
+  for (; index + sizeof(uint64_t) <= length; index += sizeof(uint64_t)) {
+    uint64_t word = 0;
+    memcpy(&word, data + index, sizeof(uint64_t));
+    hash ^= word;
+    hash *= 1099511628211ULL;
+    hash ^= hash >> 32;
+  }
+  for (; index < length; index++) {
+    hash ^= data[index];
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+
+static std::string MakeContentKey(const void* bytes, size_t length) {
+  return "content://" + std::to_string(HashBytes(bytes, length)) + "_" + std::to_string(length);
+}
+
+static bool SameBytes(const ByteData* byteData, const void* bytes, size_t length) {
+  return byteData != nullptr && byteData->length() == length &&
+         memcmp(byteData->data(), bytes, length) == 0;
+}
+
+static void TrimRecentFiles() {
+  while (!recentFiles.empty() && recentFilesSize > maxCacheSize) {
+    recentFilesSize -= recentFiles.back().size;
+    recentFiles.pop_back();
+  }
+}
+
+static void RetainRecentFile(std::shared_ptr<File> file, size_t length,
+                             const std::string& contentKey = "", const void* bytes = nullptr) {
+  std::lock_guard<std::mutex> autoLock(globalLocker);
+  if (maxCacheSize == 0) {
+    return;
+  }
+  auto result = std::find_if(recentFiles.begin(), recentFiles.end(),
+                             [&](const RecentFile& item) { return item.file == file; });
+  if (result != recentFiles.end()) {
+    recentFiles.splice(recentFiles.begin(), recentFiles, result);
+    return;
+  }
+  RecentFile recentFile = {};
+  recentFile.file = std::move(file);
+  recentFile.size = length;
+  if (!contentKey.empty()) {
+    recentFile.contentKey = contentKey;
+    recentFile.bytes = ByteData::MakeCopy(bytes, length);
+    recentFile.size += length;
+  }
+  recentFiles.push_front(std::move(recentFile));
+  recentFilesSize += recentFiles.front().size;
+  TrimRecentFiles();
+}
+
+static ByteData* MakePayloadView(const std::shared_ptr<ByteData>& payload) {
+  // 回调持有 payload 的引用，视图释放时才减少引用计数。
+  return ByteData::MakeAdopted(payload->data(), payload->length(), [payload](uint8_t*) {})
+      .release();
+}
+
+static void ShareImages(const std::shared_ptr<File>& file) {
+  std::lock_guard<std::mutex> autoLock(globalLocker);
+  for (auto imageBytes : file->images) {
+    auto fileBytes = imageBytes->fileBytes;
+    if (fileBytes == nullptr || fileBytes->length() == 0) {
+      continue;
+    }
+    auto key = MakeContentKey(fileBytes->data(), fileBytes->length()) + "_" +
+               std::to_string(imageBytes->width) + "_" + std::to_string(imageBytes->height) + "_" +
+               std::to_string(imageBytes->anchorX) + "_" + std::to_string(imageBytes->anchorY) +
+               "_" + std::to_string(imageBytes->scaleFactor);
+    auto& sharedImage = sharedImageMap[key];
+    auto payload = sharedImage.payload.lock();
+    if (payload == nullptr) {
+      payload = std::shared_ptr<ByteData>(fileBytes);
+      imageBytes->fileBytes = MakePayloadView(payload);
+      sharedImage.uniqueID = imageBytes->uniqueID;
+      sharedImage.payload = payload;
+      continue;
+    }
+    if (payload->data() == fileBytes->data() ||
+        !SameBytes(payload.get(), fileBytes->data(), fileBytes->length())) {
+      // 已经共享或者哈希冲突，不处理。
+      continue;
+    }
+    imageBytes->uniqueID = sharedImage.uniqueID;
+    imageBytes->fileBytes = MakePayloadView(payload);
+    delete fileBytes;
+  }
+  if (sharedImageMap.size() > 50) {  // do cleaning.
+    for (auto iter = sharedImageMap.begin(); iter != sharedImageMap.end();) {
+      if (iter->second.payload.expired()) {
+        iter = sharedImageMap.erase(iter);
+      } else {
+        iter++;
+      }
+    }
+  }
+}
+
+static std::shared_ptr<File> FindFileByContent(const std::string& contentKey, const void* bytes,
+                                               size_t length) {
+  std::lock_guard<std::mutex> autoLock(globalLocker);
+  auto result = std::find_if(recentFiles.begin(), recentFiles.end(), [&](const RecentFile& item) {
+    return item.contentKey == contentKey && SameBytes(item.bytes.get(), bytes, length);
+  });
+  if (result == recentFiles.end()) {
+    return nullptr;
+  }
+  recentFiles.splice(recentFiles.begin(), recentFiles, result);
+  return result->file;
+}
+
+static bool ContentCacheEnabled() {
+  std::lock_guard<std::mutex> autoLock(globalLocker);
+  return maxCacheSize > 0;
+}
+
 static std::shared_ptr<File> FindFileByPath(const std::string& filePath) {
   std::lock_guard<std::mutex> autoLock(globalLocker);
   if (filePath.empty()) {
@@ -66,16 +213,38 @@ uint16_t File::MaxSupportedTagLevel() {
   return Codec::MaxSupportedTagLevel();
 }
 
+void File::SetMaxCacheSize(size_t bytes) {
+  std::lock_guard<std::mutex> autoLock(globalLocker);
+  maxCacheSize = bytes;
+  TrimRecentFiles();
+}
+
 std::shared_ptr<File> File::Load(const void* bytes, size_t length, const std::string& filePath) {
-  auto file = FindFileByPath(filePath);
+  if (bytes == nullptr || length == 0) {
+    return nullptr;
+  }
+  // 没有路径时，只有设置了缓存大小才按内容缓存，相同的数据只解码一次。
+  std::string contentKey =
+      filePath.empty() && ContentCacheEnabled() ? MakeContentKey(bytes, length) : "";
+  std::shared_ptr<File> file = nullptr;
+  if (!contentKey.empty()) {
+    file = FindFileByContent(contentKey, bytes, length);
+  } else {
+    file = FindFileByPath(filePath);
+  }
   if (file != nullptr) {
+    RetainRecentFile(file, length);
     return file;
   }
   file = Codec::Decode(bytes, static_cast<uint32_t>(length), filePath);
   if (file != nullptr) {
-    std::lock_guard<std::mutex> autoLock(globalLocker);
-    std::weak_ptr<File> weak = file;
-    weakFileMap.insert(std::make_pair(filePath, std::move(weak)));
+    ShareImages(file);
+    if (!filePath.empty()) {
+      std::lock_guard<std::mutex> autoLock(globalLocker);
+      std::weak_ptr<File> weak = file;
+      weakFileMap[filePath] = std::move(weak);
+    }
+    RetainRecentFile(file, length, contentKey, bytes);
   }
   return file;
 }
@@ -27,6 +27,11 @@
 #include <vector>
 
 namespace pag {
+/**
+ * Returns the number of CPU cores of current device.
+ */
+int GetCPUCores();
+
 class Executor {
  public:
   virtual ~Executor() = default;
@@ -16,12 +16,14 @@
 //
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
+#include <cstring>
 #include <unordered_map>
 #include <unordered_set>
 #include "Compression.h"
 #include "base/utils/USE.h"
 #include "base/utils/Verify.h"
 #include "codec/Version.h"
+#include "codec/tags/FileAttributes.h"
 #include "codec/tags/FileTags.h"
 #include "codec/tags/PerformanceTag.h"
 #include "pag/file.h"
@@ -167,7 +169,7 @@ std::shared_ptr<File> Codec::VerifyAndMake(const std::vector<pag::Composition*>&
   return std::shared_ptr<File>(file);
 }
 
-DecodeStream ReadBodyBytes(DecodeStream* stream) {
+DecodeStream ReadBodyBytes(DecodeStream* stream, char* compression) {
   DecodeStream emptyStream(stream->context);
   if (stream->length() < 11) {
     Throw(stream->context, "Length of PAG file is too short.");
@@ -186,8 +188,9 @@ DecodeStream ReadBodyBytes(DecodeStream* stream) {
     return emptyStream;
   }
   auto bodyLength = stream->readUint32();
-  auto compression = stream->readInt8();
-  if (compression != CompressionAlgorithm::UNCOMPRESSED) {
+  *compression = stream->readInt8();
+  if (*compression != CompressionAlgorithm::UNCOMPRESSED &&
+      *compression != CompressionAlgorithm::ZLIB) {
     Throw(stream->context, "Invalid PAG file header.");
     return emptyStream;
   }
@@ -195,15 +198,250 @@ DecodeStream ReadBodyBytes(DecodeStream* stream) {
   return stream->readBytes(bodyLength);
 }
 
+/**
+ * The body of a compressed PAG file is a list of chunks, one chunk for each top-level tag, so that
+ * the tags can be decompressed one by one and the unneeded ones can be skipped. Every chunk starts
+ * with the tag code, the length of the original tag bytes (including the tag header) and the
+ * length of the stored bytes. The tag bytes are stored as they are if they can not be compressed
+ * smaller.
+ */
+static void WriteCompressedTags(EncodeStream* stream, const ByteData* bodyBytes) {
+  DecodeStream tagStream(stream->context, bodyBytes->data(),
+                         static_cast<uint32_t>(bodyBytes->length()));
+  while (tagStream.bytesAvailable() > 0) {
+    auto tagStart = tagStream.position();
+    auto header = ReadTagHeader(&tagStream);
+    tagStream.skip(header.length);
+    auto tagBytes = bodyBytes->data() + tagStart;
+    auto tagLength = tagStream.position() - tagStart;
+    stream->writeUint16(static_cast<uint16_t>(header.code));
+    stream->writeEncodedUint32(tagLength);
+    auto compressedBytes = CompressBytes(tagBytes, tagLength);
+    if (compressedBytes != nullptr && compressedBytes->length() < tagLength) {
+      auto compressedLength = static_cast<uint32_t>(compressedBytes->length());
+      stream->writeEncodedUint32(compressedLength);
+      stream->writeBytes(compressedBytes->data(), compressedLength);
+    } else {
+      stream->writeEncodedUint32(tagLength);
+      stream->writeBytes(tagBytes, tagLength);
+    }
+    if (header.code == TagCode::End) {
+      break;
+    }
+  }
+}
+
+// The maximum compression ratio that deflate can reach is about 1032:1.
+static constexpr uint64_t MaxCompressionRatio = 1032;
+
+/**
+ * Reads the next chunk of a compressed body, returns the content bytes of the tag. The buffer is
+ * used to hold the decompressed bytes, which is valid until the next call.
+ */
+static DecodeStream ReadCompressedTag(DecodeStream* stream, std::vector<uint8_t>* buffer) {
+  DecodeStream emptyStream(stream->context);
+  auto tagLength = stream->readEncodedUint32();
+  auto storedLength = stream->readEncodedUint32();
+  auto storedBytes = stream->readBytes(storedLength);
+  if (stream->context->hasException()) {
+    return emptyStream;
+  }
+  auto tagStream = storedBytes;
+  if (storedLength != tagLength) {
+    // The tag length comes from the file, check it before allocating. A compressed chunk is always
+    // smaller than the tag, and deflate can not expand the data more than MaxCompressionRatio.
+    if (tagLength < storedLength || tagLength > storedLength * MaxCompressionRatio) {
+      Throw(stream->context, "Invalid compressed tag length in the PAG file.");
+      return emptyStream;
+    }
+    buffer->resize(tagLength);
+    if (!DecompressBytes(storedBytes.data(), storedLength, buffer->data(), tagLength)) {
+      Throw(stream->context, "Failed to decompress the PAG file.");
+      return emptyStream;
+    }
+    tagStream = DecodeStream(stream->context, buffer->data(), tagLength);
+  }
+  auto header = ReadTagHeader(&tagStream);
+  return tagStream.readBytes(header.length);
+}
+
+static void SkipCompressedTag(DecodeStream* stream) {
+  stream->readEncodedUint32();
+  auto storedLength = stream->readEncodedUint32();
+  stream->skip(storedLength);
+}
+
+/**
+ * Reads the next top-level tag of the body, returns the content bytes of the tag. The code is set
+ * to TagCode::End if there is no more tag to read.
+ */
+static DecodeStream ReadNextTag(DecodeStream* stream, char compression, TagCode* code,
+                                std::vector<uint8_t>* buffer) {
+  DecodeStream emptyStream(stream->context);
+  if (compression == CompressionAlgorithm::ZLIB) {
+    *code = static_cast<TagCode>(stream->readUint16());
+    if (stream->context->hasException() || *code == TagCode::End) {
+      return emptyStream;
+    }
+    return ReadCompressedTag(stream, buffer);
+  }
+  auto header = ReadTagHeader(stream);
+  *code = header.code;
+  if (stream->context->hasException() || header.code == TagCode::End) {
+    return emptyStream;
+  }
+  return stream->readBytes(header.length);
+}
+
+/**
+ * The tag index is an optional footer appended after the End tag of the body, which is ignored by
+ * the readers that don't know it. It lists the code and the offset in the body of every top-level
+ * tag, followed by the length of the index and the "PIDX" magic, so that readers can find it from
+ * the end of the body.
+ */
+struct TagIndexEntry {
+  TagCode code = TagCode::End;
+  uint32_t offset = 0;
+};
+
+static const char TagIndexMagic[] = {'P', 'I', 'D', 'X'};
+static constexpr uint32_t TagIndexTrailerLength = 8;
+
+static void WriteTagIndex(EncodeStream* stream, const ByteData* bodyBytes, char compression) {
+  DecodeStream body(stream->context, bodyBytes->data(), static_cast<uint32_t>(bodyBytes->length()));
+  std::vector<TagIndexEntry> entries = {};
+  std::vector<uint8_t> buffer = {};
+  while (body.bytesAvailable() > 0) {
+    TagIndexEntry entry = {};
+    entry.offset = body.position();
+    ReadNextTag(&body, compression, &entry.code, &buffer);
+    if (body.context->hasException() || entry.code == TagCode::End) {
+      break;
+    }
+    entries.push_back(entry);
+  }
+  EncodeStream indexBytes(stream->context);
+  indexBytes.writeEncodedUint32(static_cast<uint32_t>(entries.size()));
+  for (auto& entry : entries) {
+    indexBytes.writeUint16(static_cast<uint16_t>(entry.code));
+    indexBytes.writeEncodedUint32(entry.offset);
+  }
+  stream->writeBytes(&indexBytes);
+  stream->writeUint32(indexBytes.length());
+  for (auto magic : TagIndexMagic) {
+    stream->writeInt8(magic);
+  }
+}
+
+/**
+ * Reads the tag index from the end of the body. Returns false if the body has no tag index.
+ */
+static bool ReadTagIndex(DecodeStream* stream, std::vector<TagIndexEntry>* entries) {
+  auto bodyLength = stream->length();
+  if (bodyLength < TagIndexTrailerLength ||
+      memcmp(stream->data() + bodyLength - sizeof(TagIndexMagic), TagIndexMagic,
+             sizeof(TagIndexMagic)) != 0) {
+    return false;
+  }
+  auto indexEnd = bodyLength - TagIndexTrailerLength;
+  DecodeStream trailer(stream->context, stream->data() + indexEnd, TagIndexTrailerLength);
+  auto indexLength = trailer.readUint32();
+  if (indexLength > indexEnd) {
+    return false;
+  }
+  auto indexStart = indexEnd - indexLength;
+  DecodeStream indexBytes(stream->context, stream->data() + indexStart, indexLength);
+  auto count = indexBytes.readEncodedUint32();
+  for (uint32_t i = 0; i < count && !stream->context->hasException(); i++) {
+    TagIndexEntry entry = {};
+    entry.code = static_cast<TagCode>(indexBytes.readUint16());
+    entry.offset = indexBytes.readEncodedUint32();
+    if (entry.offset >= indexStart) {
+      return false;
+    }
+    entries->push_back(entry);
+  }
+  return !stream->context->hasException();
+}
+
+/**
+ * Finds the first top-level tag of the specified code and returns its content bytes in tagBytes.
+ * The tag is located by the tag index if there is one, otherwise, the tags are scanned one by one
+ * and only the matching one is decompressed.
+ */
+static bool FindTag(DecodeStream* stream, char compression, TagCode code,
+                    std::vector<uint8_t>* buffer, DecodeStream* tagBytes) {
+  std::vector<TagIndexEntry> entries = {};
+  if (ReadTagIndex(stream, &entries)) {
+    for (auto& entry : entries) {
+      if (entry.code == code) {
+        stream->setPosition(entry.offset);
+        TagCode tagCode = TagCode::End;
+        *tagBytes = ReadNextTag(stream, compression, &tagCode, buffer);
+        return tagCode == code && !stream->context->hasException();
+      }
+    }
+    return false;
+  }
+  while (stream->bytesAvailable() > 0 && !stream->context->hasException()) {
+    if (compression == CompressionAlgorithm::ZLIB) {
+      auto tagCode = static_cast<TagCode>(stream->readUint16());
+      if (tagCode == TagCode::End) {
+        return false;
+      }
+      if (tagCode != code) {
+        SkipCompressedTag(stream);
+        continue;
+      }
+      *tagBytes = ReadCompressedTag(stream, buffer);
+    } else {
+      auto header = ReadTagHeader(stream);
+      if (header.code == TagCode::End) {
+        return false;
+      }
+      auto bytes = stream->readBytes(header.length);
+      if (header.code != code) {
+        continue;
+      }
+      *tagBytes = bytes;
+    }
+    return !stream->context->hasException();
+  }
+  return false;
+}
+
+static void ReadCompressedTagsOfFile(DecodeStream* stream, CodecContext* context) {
+  std::vector<uint8_t> buffer = {};
+  while (stream->bytesAvailable() > 0) {
+    auto code = static_cast<TagCode>(stream->readUint16());
+    if (context->hasException() || code == TagCode::End) {
+      return;
+    }
+    auto tagBytes = ReadCompressedTag(stream, &buffer);
+    if (context->hasException()) {
+      return;
+    }
+    ReadTagsOfFile(&tagBytes, code, context);
+    if (context->hasException()) {
+      return;
+    }
+  }
+}
+
 std::shared_ptr<File> Codec::Decode(const void* bytes, uint32_t byteLength,
                                     const std::string& filePath) {
   CodecContext context = {};
   DecodeStream stream(&context, reinterpret_cast<const uint8_t*>(bytes), byteLength);
-  auto bodyBytes = ReadBodyBytes(&stream);
+  char compression = CompressionAlgorithm::UNCOMPRESSED;
+  auto bodyBytes = ReadBodyBytes(&stream, &compression);
   if (context.hasException()) {
     return nullptr;
   }
-  ReadTags(&bodyBytes, &context, ReadTagsOfFile);
+  if (compression == CompressionAlgorithm::ZLIB) {
+    ReadCompressedTagsOfFile(&bodyBytes, &context);
+  } else {
+    ReadTags(&bodyBytes, &context, ReadTagsOfFile);
+  }
   InstallReferences(context.compositions);
   if (context.hasException()) {
     return nullptr;
@@ -242,9 +480,28 @@ std::unique_ptr<ByteData> Codec::Encode(std::shared_ptr<File> file) {
 
 std::unique_ptr<ByteData> Codec::Encode(std::shared_ptr<File> file,
                                         std::shared_ptr<PerformanceData> performanceData) {
+  return Codec::Encode(file, performanceData, false);
+}
+
+std::unique_ptr<ByteData> Codec::Encode(std::shared_ptr<File> file,
+                                        std::shared_ptr<PerformanceData> performanceData,
+                                        bool compressed, bool tagIndexEnabled) {
+  if (file == nullptr) {
+    return nullptr;
+  }
   CodecContext context = {};
   EncodeStream bodyBytes(&context);
   WriteTagsOfFile(&bodyBytes, file.get(), performanceData.get());
+  if (compressed) {
+    auto tagBytes = bodyBytes.release();
+    WriteCompressedTags(&bodyBytes, tagBytes.get());
+  }
+  if (tagIndexEnabled) {
+    auto tagBytes = bodyBytes.release();
+    bodyBytes.writeBytes(tagBytes->data(), static_cast<uint32_t>(tagBytes->length()));
+    WriteTagIndex(&bodyBytes, tagBytes.get(),
+                  compressed ? CompressionAlgorithm::ZLIB : CompressionAlgorithm::UNCOMPRESSED);
+  }
 
   EncodeStream fileBytes(&context);
   fileBytes.writeInt8('P');
@@ -252,7 +509,7 @@ std::unique_ptr<ByteData> Codec::Encode(std::shared_ptr<File> file,
   fileBytes.writeInt8('G');
   fileBytes.writeUint8(Version);
   fileBytes.writeUint32(bodyBytes.length());
-  fileBytes.writeInt8(CompressionAlgorithm::UNCOMPRESSED);
+  fileBytes.writeInt8(compressed ? CompressionAlgorithm::ZLIB : CompressionAlgorithm::UNCOMPRESSED);
   fileBytes.writeBytes(&bodyBytes);
   return fileBytes.release();
 }
@@ -261,27 +518,39 @@ std::shared_ptr<PerformanceData> Codec::ReadPerformanceData(const void* bytes,
                                                             uint32_t byteLength) {
   CodecContext context = {};
   DecodeStream stream(&context, reinterpret_cast<const uint8_t*>(bytes), byteLength);
-  auto bodyBytes = ReadBodyBytes(&stream);
+  char compression = CompressionAlgorithm::UNCOMPRESSED;
+  auto bodyBytes = ReadBodyBytes(&stream, &compression);
   if (context.hasException()) {
     return nullptr;
   }
-  auto header = ReadTagHeader(&bodyBytes);
-  if (context.hasException()) {
+  std::vector<uint8_t> buffer = {};
+  DecodeStream tagBytes(&context);
+  if (!FindTag(&bodyBytes, compression, TagCode::Performance, &buffer, &tagBytes)) {
     return nullptr;
   }
+  auto data = std::shared_ptr<PerformanceData>(new PerformanceData());
+  ReadPerformanceTag(&tagBytes, data.get());
+  return data;
+}
 
-  while (header.code != TagCode::End) {
-    auto tagBytes = bodyBytes.readBytes(header.length);
-    if (header.code == TagCode::Performance) {
-      auto data = std::shared_ptr<PerformanceData>(new PerformanceData());
-      ReadPerformanceTag(&tagBytes, data.get());
-      return data;
-    }
-    header = ReadTagHeader(&bodyBytes);
-    if (context.hasException()) {
-      return nullptr;
-    }
+std::shared_ptr<FileAttributes> Codec::ReadFileAttributes(const void* bytes, uint32_t byteLength) {
+  CodecContext context = {};
+  DecodeStream stream(&context, reinterpret_cast<const uint8_t*>(bytes), byteLength);
+  char compression = CompressionAlgorithm::UNCOMPRESSED;
+  auto bodyBytes = ReadBodyBytes(&stream, &compression);
+  if (context.hasException()) {
+    return nullptr;
+  }
+  std::vector<uint8_t> buffer = {};
+  DecodeStream tagBytes(&context);
+  if (!FindTag(&bodyBytes, compression, TagCode::FileAttributes, &buffer, &tagBytes)) {
+    return nullptr;
+  }
+  auto fileAttributes = std::make_shared<FileAttributes>();
+  pag::ReadFileAttributes(&tagBytes, fileAttributes.get());
+  if (context.hasException()) {
+    return nullptr;
   }
-  return nullptr;
+  return fileAttributes;
 }
 }  // namespace pag
@@ -0,0 +1,66 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2021 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "Compression.h"
+#ifdef PAG_USE_ZLIB
+#include <zlib.h>
+#endif
+
+namespace pag {
+#ifdef PAG_USE_ZLIB
+
+std::unique_ptr<ByteData> CompressBytes(const uint8_t* bytes, uint32_t length) {
+  if (bytes == nullptr || length == 0) {
+    return nullptr;
+  }
+  auto capacity = compressBound(length);
+  auto data = ByteData::Make(capacity);
+  if (data == nullptr) {
+    return nullptr;
+  }
+  auto dstLength = static_cast<uLongf>(capacity);
+  if (compress2(data->data(), &dstLength, bytes, length, Z_BEST_COMPRESSION) != Z_OK) {
+    return nullptr;
+  }
+  return ByteData::MakeCopy(data->data(), dstLength);
+}
+
+bool DecompressBytes(const uint8_t* bytes, uint32_t length, uint8_t* dstBytes,
+                     uint32_t dstLength) {
+  if (bytes == nullptr || dstBytes == nullptr) {
+    return false;
+  }
+  auto outputLength = static_cast<uLongf>(dstLength);
+  if (uncompress(dstBytes, &outputLength, bytes, length) != Z_OK) {
+    return false;
+  }
+  return outputLength == dstLength;
+}
+
+#else
+
+std::unique_ptr<ByteData> CompressBytes(const uint8_t*, uint32_t) {
+  return nullptr;
+}
+
+bool DecompressBytes(const uint8_t*, uint32_t, uint8_t*, uint32_t) {
+  return false;
+}
+
+#endif
+}  // namespace pag
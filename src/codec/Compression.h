@@ -18,10 +18,24 @@
 
 #pragma once
 
+#include "pag/file.h"
+
 namespace pag {
 namespace CompressionAlgorithm {
 static const char UNCOMPRESSED = 'U';
 static const char ZLIB = 'Z';
 static const char LZMA = 'L';
 };  // namespace CompressionAlgorithm
+
+/**
+ * Compresses the specified bytes with zlib. Returns nullptr if zlib is not available in current
+ * build or the compression fails.
+ */
+std::unique_ptr<ByteData> CompressBytes(const uint8_t* bytes, uint32_t length);
+
+/**
+ * Decompresses the zlib compressed bytes into dstBytes, which must have exactly dstLength bytes
+ * available. Returns false if zlib is not available in current build or the decompression fails.
+ */
+bool DecompressBytes(const uint8_t* bytes, uint32_t length, uint8_t* dstBytes, uint32_t dstLength);
 }  // namespace pag
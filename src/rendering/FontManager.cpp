@@ -17,11 +17,15 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "FontManager.h"
+#include <atomic>
 #include "base/utils/USE.h"
 #include "pag/file.h"
 #include "platform/Platform.h"
+#include "tgfx/core/UTF.h"
 
 namespace pag {
+static std::atomic<uint32_t> fallbackFontVersion = {0};
+
 std::shared_ptr<TypefaceHolder> TypefaceHolder::MakeFromName(const std::string& fontFamily,
                                                              const std::string& fontStyle) {
   auto holder = new TypefaceHolder();
@@ -139,22 +143,58 @@ std::shared_ptr<tgfx::Typeface> FontManager::getTypefaceWithoutFallback(
 
 std::shared_ptr<tgfx::Typeface> FontManager::getFallbackTypeface(const std::string& name,
                                                                  tgfx::GlyphID* glyphID) {
+  const char* start = name.data();
+  auto unichar = tgfx::UTF::NextUTF8(&start, name.data() + name.size());
+  // The name may contain more than one code point, for example, an emoji sequence.
+  auto cacheable = unichar >= 0 && start == name.data() + name.size();
+  if (cacheable) {
+    std::shared_lock<std::shared_mutex> cacheLock(cacheLocker);
+    auto result = fallbackGlyphCache.find(unichar);
+    if (result != fallbackGlyphCache.end()) {
+      *glyphID = result->second.glyphID;
+      return result->second.typeface;
+    }
+  }
+  // Probing the fallback fonts may create their typefaces, which must be serialized by locker.
   std::lock_guard<std::mutex> autoLock(locker);
+  if (cacheable) {
+    // The cache only changes under locker, check again in case another thread has resolved it.
+    auto result = fallbackGlyphCache.find(unichar);
+    if (result != fallbackGlyphCache.end()) {
+      *glyphID = result->second.glyphID;
+      return result->second.typeface;
+    }
+  }
+  FallbackGlyph glyph = {};
   for (auto& holder : fallbackFontList) {
     auto typeface = holder->getTypeface();
     if (typeface != nullptr) {
-      *glyphID = typeface->getGlyphID(name);
-      if (*glyphID != 0) {
-        return typeface;
+      glyph.glyphID = typeface->getGlyphID(name);
+      if (glyph.glyphID != 0) {
+        glyph.typeface = typeface;
+        break;
       }
     }
   }
-  return tgfx::Typeface::MakeDefault();
+  if (glyph.typeface == nullptr) {
+    glyph.typeface = tgfx::Typeface::MakeDefault();
+  }
+  if (cacheable) {
+    std::lock_guard<std::shared_mutex> cacheLock(cacheLocker);
+    fallbackGlyphCache[unichar] = glyph;
+  }
+  *glyphID = glyph.glyphID;
+  return glyph.typeface;
 }
 
 void FontManager::setFallbackFontNames(const std::vector<std::string>& fontNames) {
   std::lock_guard<std::mutex> autoLock(locker);
   fallbackFontList.clear();
+  {
+    std::lock_guard<std::shared_mutex> cacheLock(cacheLocker);
+    fallbackGlyphCache.clear();
+  }
+  fallbackFontVersion++;
   for (auto& fontFamily : fontNames) {
     auto holder = TypefaceHolder::MakeFromName(fontFamily, "");
     fallbackFontList.push_back(holder);
@@ -165,6 +205,11 @@ void FontManager::setFallbackFontPaths(const std::vector<std::string>& fontPaths
                                        const std::vector<int>& ttcIndices) {
   std::lock_guard<std::mutex> autoLock(locker);
   fallbackFontList.clear();
+  {
+    std::lock_guard<std::shared_mutex> cacheLock(cacheLocker);
+    fallbackGlyphCache.clear();
+  }
+  fallbackFontVersion++;
   int index = 0;
   for (auto& fontPath : fontPaths) {
     auto holder = TypefaceHolder::MakeFromFile(fontPath, ttcIndices[index]);
@@ -218,6 +263,10 @@ void FontManager::UnregisterFont(const PAGFont& font) {
   return fontManager.unregisterFont(font);
 }
 
+uint32_t FontManager::GetFallbackFontVersion() {
+  return fallbackFontVersion;
+}
+
 void FontManager::SetFallbackFontNames(const std::vector<std::string>& fontNames) {
   fontManager.setFallbackFontNames(fontNames);
 }
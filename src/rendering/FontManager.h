@@ -18,6 +18,7 @@
 
 #pragma once
 
+#include <shared_mutex>
 #include <unordered_map>
 #include "pag/pag.h"
 #include "tgfx/core/Typeface.h"
@@ -41,6 +42,11 @@ class TypefaceHolder {
   std::shared_ptr<tgfx::Typeface> typeface = nullptr;
 };
 
+struct FallbackGlyph {
+  std::shared_ptr<tgfx::Typeface> typeface = nullptr;
+  tgfx::GlyphID glyphID = 0;
+};
+
 class FontManager {
  public:
   static std::shared_ptr<tgfx::Typeface> GetTypefaceWithoutFallback(const std::string& fontFamily,
@@ -61,6 +67,11 @@ class FontManager {
   static void SetFallbackFontPaths(const std::vector<std::string>& fontPaths,
                                    const std::vector<int>& ttcIndices);
 
+  /**
+   * Returns the version of the fallback font list, which increases every time the list changes.
+   */
+  static uint32_t GetFallbackFontVersion();
+
   ~FontManager();
 
   bool hasFallbackFonts();
@@ -90,7 +101,12 @@ class FontManager {
 
   std::unordered_map<std::string, std::shared_ptr<tgfx::Typeface>> registeredFontMap;
   std::vector<std::shared_ptr<TypefaceHolder>> fallbackFontList;
+  // Resolved fallback glyphs keyed by unicode code point, including the ones not found in any
+  // fallback font. It is cleared when the fallback font list changes. Lookups only take a shared
+  // lock on cacheLocker, while writers must hold locker first and then lock cacheLocker.
+  std::unordered_map<int32_t, FallbackGlyph> fallbackGlyphCache;
   std::mutex locker = {};
+  std::shared_mutex cacheLocker = {};
 
   std::shared_ptr<tgfx::Typeface> getTypefaceFromCache(const std::string& fontFamily,
                                                        const std::string& fontStyle);
@@ -38,6 +38,10 @@ std::shared_ptr<PAGFile> PAGFile::Load(const std::string& filePath) {
   return MakeFrom(file);
 }
 
+void PAGFile::SetMaxCacheSize(size_t bytes) {
+  File::SetMaxCacheSize(bytes);
+}
+
 std::shared_ptr<PAGFile> PAGFile::MakeFrom(std::shared_ptr<File> file) {
   if (file == nullptr) {
     return nullptr;
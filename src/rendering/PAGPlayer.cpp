@@ -25,6 +25,7 @@
 #include "rendering/utils/ApplyScaleMode.h"
 #include "rendering/utils/LockGuard.h"
 #include "rendering/utils/ScopedLock.h"
+#include "rendering/utils/Tracer.h"
 #include "tgfx/core/Clock.h"
 
 namespace pag {
@@ -263,6 +264,18 @@ void PAGPlayer::prepareInternal() {
   }
 }
 
+bool PAGPlayer::warmUp() {
+  LockGuard autoLock(rootLocker);
+  if (pagSurface == nullptr) {
+    return false;
+  }
+  auto root = stage->getRootComposition();
+  if (root == nullptr) {
+    return false;
+  }
+  return pagSurface->warmUp(renderCache, root.get());
+}
+
 bool PAGPlayer::wait(const BackendSemaphore& waitSemaphore) {
   LockGuard autoLock(rootLocker);
   if (pagSurface == nullptr) {
@@ -285,6 +298,7 @@ bool PAGPlayer::flushInternal(BackendSemaphore* signalSemaphore) {
   if (pagSurface == nullptr) {
     return false;
   }
+  TRACE_SPAN("PAGPlayer::flush");
   renderCache->beginFrame();
   updateStageSize();
   tgfx::Clock clock = {};
@@ -398,6 +412,11 @@ int64_t PAGPlayer::graphicsMemory() {
   return renderCache->memoryUsage();
 }
 
+int64_t PAGPlayer::predictedGraphicsMemory() {
+  LockGuard autoLock(rootLocker);
+  return renderCache->predictedMemoryUsage();
+}
+
 void PAGPlayer::updateStageSize() {
   if (pagSurface == nullptr) {
     return;
@@ -22,8 +22,11 @@
 #include "rendering/Drawable.h"
 #include "rendering/caches/RenderCache.h"
 #include "rendering/graphics/Recorder.h"
+#include "rendering/utils/DevicePool.h"
 #include "rendering/utils/GLRestorer.h"
 #include "rendering/utils/LockGuard.h"
+#include "rendering/utils/Tracer.h"
+#include "rendering/video/VideoDecoderPool.h"
 #include "tgfx/core/Clock.h"
 #include "tgfx/gpu/opengl/GLDevice.h"
 
@@ -72,14 +75,31 @@ std::shared_ptr<PAGSurface> PAGSurface::MakeFrom(const BackendTexture& texture,
 }
 
 std::shared_ptr<PAGSurface> PAGSurface::MakeOffscreen(int width, int height) {
-  auto device = tgfx::GLDevice::Make();
-  if (device == nullptr || width <= 0 || height <= 0) {
+  return MakeOffscreen(width, height, false);
+}
+
+std::shared_ptr<PAGSurface> PAGSurface::MakeOffscreen(int width, int height,
+                                                      bool useSharedDevice) {
+  if (width <= 0 || height <= 0) {
+    return nullptr;
+  }
+  std::shared_ptr<tgfx::Device> device = nullptr;
+  if (useSharedDevice) {
+    device = DevicePool::Acquire();
+  } else {
+    device = tgfx::GLDevice::Make();
+  }
+  if (device == nullptr) {
     return nullptr;
   }
   auto drawable = std::make_shared<OffscreenDrawable>(width, height, device);
   return std::shared_ptr<PAGSurface>(new PAGSurface(drawable));
 }
 
+void PAGSurface::SetMaxSharedDeviceCount(int count) {
+  DevicePool::SetMaxDeviceCount(count);
+}
+
 PAGSurface::PAGSurface(std::shared_ptr<Drawable> drawable, bool contextAdopted)
     : drawable(std::move(drawable)), contextAdopted(contextAdopted) {
   rootLocker = std::make_shared<std::mutex>();
@@ -110,6 +130,7 @@ void PAGSurface::freeCacheInternal() {
   if (pagPlayer) {
     pagPlayer->renderCache->releaseAll();
   }
+  VideoDecoderPool::PurgeAll();
   surface = nullptr;
   auto context = drawable->lockContext();
   if (context) {
@@ -188,12 +209,15 @@ bool PAGSurface::draw(RenderCache* cache, std::shared_ptr<Graphic> graphic,
   if (graphic) {
     graphic->draw(canvas, cache);
   }
-  if (signalSemaphore == nullptr) {
-    surface->flush();
-  } else {
-    tgfx::GLSemaphore semaphore = {};
-    surface->flush(&semaphore);
-    signalSemaphore->initGL(semaphore.glSync);
+  {
+    TRACE_SPAN("Surface::flush");
+    if (signalSemaphore == nullptr) {
+      surface->flush();
+    } else {
+      tgfx::GLSemaphore semaphore = {};
+      surface->flush(&semaphore);
+      signalSemaphore->initGL(semaphore.glSync);
+    }
   }
   cache->detachFromContext();
   drawable->setTimeStamp(pagPlayer->getTimeStampInternal());
@@ -241,6 +265,25 @@ bool PAGSurface::hitTest(RenderCache* cache, std::shared_ptr<Graphic> graphic, f
   return result;
 }
 
+bool PAGSurface::warmUp(RenderCache* cache, PAGLayer* pagLayer) {
+  if (cache == nullptr || pagLayer == nullptr) {
+    return false;
+  }
+  if (!drawable->prepareDevice()) {
+    return false;
+  }
+  auto context = lockContext();
+  if (!context) {
+    return false;
+  }
+  cache->attachToContext(context);
+  cache->warmUpFilters(pagLayer);
+  // 预热不是一次绘制，usedAssets 仍是上一帧的记录，不能据此清理正在播放的缓存。
+  cache->detachFromContext(false);
+  unlockContext();
+  return true;
+}
+
 tgfx::Context* PAGSurface::lockContext() {
   auto context = drawable->lockContext();
   if (context != nullptr && contextAdopted) {
@@ -18,6 +18,7 @@
 
 #include "ContentCache.h"
 #include "rendering/graphics/Picture.h"
+#include "rendering/utils/Tracer.h"
 
 namespace pag {
 ContentCache::ContentCache(Layer* layer)
@@ -88,6 +89,7 @@ bool ContentCache::checkCacheEnabled() {
 }
 
 Content* ContentCache::createCache(Frame layerFrame) {
+  TRACE_LAYER_SPAN("ContentCache::createCache", layer);
   auto content = createContent(layerFrame);
   if (_cacheFilters) {
     auto filterModifier = FilterModifier::Make(layer, layerFrame);
@@ -31,7 +31,9 @@ class ImageBytesCache : public Cache {
     auto fileBytes =
         tgfx::Data::MakeWithoutCopy(imageBytes->fileBytes->data(), imageBytes->fileBytes->length());
     auto image = tgfx::Image::MakeFrom(std::move(fileBytes));
-    auto picture = Picture::MakeFrom(imageBytes->uniqueID, image);
+    // The uniqueID is shared by the ImageBytes of the same content in different files, use it as
+    // the content key so that they share the same cached texture.
+    auto picture = Picture::MakeFrom(imageBytes->uniqueID, image, imageBytes->uniqueID);
     auto matrix = tgfx::Matrix::MakeScale(1 / imageBytes->scaleFactor);
     matrix.postTranslate(static_cast<float>(-imageBytes->anchorX),
                          static_cast<float>(-imageBytes->anchorY));
@@ -18,6 +18,7 @@
 
 #include "LayerCache.h"
 #include "base/utils/TGFXCast.h"
+#include "base/utils/UniqueID.h"
 #include "rendering/caches/ImageContentCache.h"
 #include "rendering/caches/PreComposeContentCache.h"
 #include "rendering/caches/ShapeContentCache.h"
@@ -132,8 +133,9 @@ void LayerCache::updateStaticTimeRanges() {
     MergeTimeRanges(&staticTimeRanges, maskCache->getStaticTimeRanges());
   }
   if (layer->trackMatteLayer) {
-    auto timeRanges = getTrackMatteStaticTimeRanges();
-    MergeTimeRanges(&staticTimeRanges, &timeRanges);
+    trackMatteID = UniqueID::Next();
+    trackMatteStaticTimeRanges = getTrackMatteStaticTimeRanges();
+    MergeTimeRanges(&staticTimeRanges, &trackMatteStaticTimeRanges);
   }
   if (!layer->layerStyles.empty() || !layer->effects.empty()) {
     auto timeRanges = getFilterStaticTimeRanges();
@@ -151,6 +153,16 @@ void LayerCache::updateStaticTimeRanges() {
   }
 }
 
+const TimeRange* LayerCache::findTrackMatteStaticTimeRange(Frame contentFrame) const {
+  for (auto& timeRange : trackMatteStaticTimeRanges) {
+    if (timeRange.start <= contentFrame && contentFrame <= timeRange.end) {
+      // 单帧的区间没有复用价值。
+      return timeRange.start < timeRange.end ? &timeRange : nullptr;
+    }
+  }
+  return nullptr;
+}
+
 std::vector<TimeRange> LayerCache::getTrackMatteStaticTimeRanges() {
   auto trackMatteLayer = layer->trackMatteLayer;
   std::vector<TimeRange> timeRanges = {trackMatteLayer->visibleRange()};
@@ -60,6 +60,19 @@ class LayerCache : public Cache {
     return contentCache->cacheFilters();
   }
 
+  /**
+   * Returns the ID used to cache the rendered track matte of this layer.
+   */
+  ID getTrackMatteID() const {
+    return trackMatteID;
+  }
+
+  /**
+   * Returns the time range in which the track matte of this layer stays unchanged, or nullptr if
+   * the track matte is varying at the specified frame.
+   */
+  const TimeRange* findTrackMatteStaticTimeRange(Frame contentFrame) const;
+
  private:
   Layer* layer = nullptr;
   TransformCache* transformCache = nullptr;
@@ -67,6 +80,8 @@ class LayerCache : public Cache {
   ContentCache* contentCache = nullptr;
   tgfx::Point maxScaleFactor = {};
   std::vector<TimeRange> staticTimeRanges;
+  ID trackMatteID = 0;
+  std::vector<TimeRange> trackMatteStaticTimeRanges;
 
   explicit LayerCache(Layer* layer);
   void updateStaticTimeRanges();
@@ -0,0 +1,74 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2021 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "MemoryPredictor.h"
+#include <algorithm>
+#include <unordered_map>
+#include "rendering/utils/MemoryCalculator.h"
+
+namespace pag {
+std::unique_ptr<MemoryPredictor> MemoryPredictor::Make(std::shared_ptr<File> file) {
+  if (file == nullptr) {
+    return nullptr;
+  }
+  auto rootLayer = file->getRootLayer();
+  std::unordered_map<void*, tgfx::Point> resourcesMaxScaleMap;
+  std::unordered_map<void*, std::vector<TimeRange>*> resourcesTimeRangesMap;
+  MemoryCalculator::CaculateResourcesMaxScaleAndTimeRanges(rootLayer, resourcesMaxScaleMap,
+                                                           resourcesTimeRangesMap);
+  auto memoriesPerFrame = MemoryCalculator::GetRootLayerGraphicsMemoriesPreFrame(
+      rootLayer, resourcesMaxScaleMap, resourcesTimeRangesMap);
+  for (auto& item : resourcesTimeRangesMap) {
+    delete item.second;
+  }
+  if (memoriesPerFrame.empty()) {
+    return nullptr;
+  }
+  return std::unique_ptr<MemoryPredictor>(new MemoryPredictor(std::move(memoriesPerFrame)));
+}
+
+MemoryPredictor::MemoryPredictor(std::vector<int64_t> memoriesPerFrame)
+    : memoriesPerFrame(std::move(memoriesPerFrame)) {
+}
+
+int64_t MemoryPredictor::memoryAt(Frame frame) const {
+  auto totalFrames = duration();
+  if (frame < 0) {
+    frame = 0;
+  } else if (frame >= totalFrames) {
+    frame = totalFrames - 1;
+  }
+  return memoriesPerFrame[static_cast<size_t>(frame)];
+}
+
+int64_t MemoryPredictor::peakMemoryIn(Frame frame, Frame frameCount) const {
+  auto totalFrames = duration();
+  if (frame < 0) {
+    frame = 0;
+  } else if (frame >= totalFrames) {
+    frame = totalFrames - 1;
+  }
+  frameCount = std::max(std::min(frameCount, totalFrames), static_cast<Frame>(1));
+  int64_t peakMemory = 0;
+  for (Frame i = 0; i < frameCount; i++) {
+    auto index = static_cast<size_t>((frame + i) % totalFrames);
+    peakMemory = std::max(peakMemory, memoriesPerFrame[index]);
+  }
+  return peakMemory;
+}
+}  // namespace pag
@@ -0,0 +1,61 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2021 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "pag/file.h"
+
+namespace pag {
+/**
+ * MemoryPredictor holds the graphics memory estimated by MemoryCalculator for every frame of a
+ * File. The estimates are measured at the original size of the File, which should be scaled by
+ * the square of the rendering scale before comparing with the actual graphics memory.
+ */
+class MemoryPredictor {
+ public:
+  /**
+   * Creates a MemoryPredictor for the specified file. Returns nullptr if the file is nullptr or has
+   * no frame to predict.
+   */
+  static std::unique_ptr<MemoryPredictor> Make(std::shared_ptr<File> file);
+
+  /**
+   * Returns the total number of frames of the file.
+   */
+  Frame duration() const {
+    return static_cast<Frame>(memoriesPerFrame.size());
+  }
+
+  /**
+   * Returns the estimated graphics memory of the specified frame.
+   */
+  int64_t memoryAt(Frame frame) const;
+
+  /**
+   * Returns the largest estimated graphics memory from the specified frame to the following
+   * frameCount frames. The range wraps around to the first frame of the file, since most animations
+   * are played in loop.
+   */
+  int64_t peakMemoryIn(Frame frame, Frame frameCount) const;
+
+ private:
+  std::vector<int64_t> memoriesPerFrame = {};
+
+  explicit MemoryPredictor(std::vector<int64_t> memoriesPerFrame);
+};
+}  // namespace pag
@@ -18,12 +18,16 @@
 
 #include "RenderCache.h"
 #include <functional>
+#include "base/utils/TGFXCast.h"
 #include "base/utils/TimeUtil.h"
 #include "base/utils/UniqueID.h"
 #include "rendering/caches/ImageContentCache.h"
 #include "rendering/caches/LayerCache.h"
 #include "rendering/renderers/FilterRenderer.h"
+#include "rendering/utils/Tracer.h"
+#include "rendering/video/VideoDecoderPool.h"
 #include "tgfx/core/Clock.h"
+#include "tgfx/gpu/Surface.h"
 
 namespace pag {
 // 300M设置的大一些用于兜底，通常在大于20M时就开始随时清理。
@@ -32,14 +36,38 @@ namespace pag {
 #define PURGEABLE_EXPIRED_FRAME 10
 #define SCALE_FACTOR_PRECISION 0.001f
 
+class MemoryPredictorTask : public Executor {
+ public:
+  static std::shared_ptr<Task> MakeAndRun(std::shared_ptr<File> file) {
+    auto task = Task::Make(std::unique_ptr<MemoryPredictorTask>(new MemoryPredictorTask(file)));
+    task->run();
+    return task;
+  }
+
+  std::unique_ptr<MemoryPredictor> getPredictor() {
+    return std::move(predictor);
+  }
+
+ private:
+  std::shared_ptr<File> file = nullptr;
+  std::unique_ptr<MemoryPredictor> predictor = nullptr;
+
+  explicit MemoryPredictorTask(std::shared_ptr<File> file) : file(std::move(file)) {
+  }
+
+  void execute() override {
+    predictor = MemoryPredictor::Make(file);
+  }
+};
+
 class ImageTask : public Executor {
  public:
   static std::shared_ptr<Task> MakeAndRun(std::shared_ptr<tgfx::Image> image,
-                                          std::shared_ptr<File> file) {
+                                          std::shared_ptr<File> file, float scaleFactor) {
     if (image == nullptr) {
       return nullptr;
     }
-    auto bitmap = new ImageTask(std::move(image), file);
+    auto bitmap = new ImageTask(std::move(image), file, scaleFactor);
     auto task = Task::Make(std::unique_ptr<ImageTask>(bitmap));
     task->run();
     return task;
@@ -54,17 +82,21 @@ class ImageTask : public Executor {
   std::shared_ptr<tgfx::Image> image = nullptr;
   // Make a reference to file when image made from imageByte of file.
   std::shared_ptr<File> file = nullptr;
+  float scaleFactor = 1.0f;
 
-  explicit ImageTask(std::shared_ptr<tgfx::Image> image, std::shared_ptr<File> file)
-      : image(std::move(image)), file(std::move(file)) {
+  explicit ImageTask(std::shared_ptr<tgfx::Image> image, std::shared_ptr<File> file,
+                     float scaleFactor)
+      : image(std::move(image)), file(std::move(file)), scaleFactor(scaleFactor) {
   }
 
   void execute() override {
-    buffer = image->makeBuffer();
+    TRACE_SPAN("Image::makeBuffer");
+    buffer = image->makeBuffer(scaleFactor);
   }
 };
 
-RenderCache::RenderCache(PAGStage* stage) : _uniqueID(UniqueID::Next()), stage(stage) {
+RenderCache::RenderCache(PAGStage* stage)
+    : _uniqueID(UniqueID::Next()), stage(stage), memoryBudget(PURGEABLE_GRAPHICS_MEMORY) {
 }
 
 RenderCache::~RenderCache() {
@@ -95,14 +127,12 @@ bool RenderCache::initFilter(Filter* filter) {
 }
 
 void RenderCache::prepareLayers(int64_t timeDistance) {
-  auto layerDistances = stage->findNearlyVisibleLayersIn(timeDistance);
-  for (auto& item : layerDistances) {
-    for (auto pagLayer : item.second) {
-      if (pagLayer->layerType() == LayerType::PreCompose) {
-        preparePreComposeLayer(static_cast<PreComposeLayer*>(pagLayer->layer));
-      } else if (pagLayer->layerType() == LayerType::Image) {
-        prepareImageLayer(static_cast<PAGImageLayer*>(pagLayer));
-      }
+  auto& layers = stage->findNearlyVisibleLayersIn(timeDistance);
+  for (auto pagLayer : layers) {
+    if (pagLayer->layerType() == LayerType::PreCompose) {
+      preparePreComposeLayer(static_cast<PreComposeLayer*>(pagLayer->layer));
+    } else if (pagLayer->layerType() == LayerType::Image) {
+      prepareImageLayer(static_cast<PAGImageLayer*>(pagLayer));
     }
   }
 }
@@ -166,6 +196,7 @@ void RenderCache::clearExpiredSequences() {
   for (auto& id : expiredSequences) {
     clearSequenceCache(id);
   }
+  VideoDecoderPool::PurgeExpired();
 }
 
 bool RenderCache::snapshotEnabled() const {
@@ -183,6 +214,48 @@ void RenderCache::setSnapshotEnabled(bool value) {
 void RenderCache::beginFrame() {
   usedAssets = {};
   resetPerformance();
+  updateMemoryBudget();
+}
+
+void RenderCache::updateMemoryBudget() {
+  predictedMemory = 0;
+  memoryBudget = PURGEABLE_GRAPHICS_MEMORY;
+  auto pagComposition = stage->getRootComposition();
+  if (pagComposition == nullptr || !pagComposition->isPAGFile()) {
+    predictedFile.reset();
+    predictorTask = nullptr;
+    memoryPredictor = nullptr;
+    return;
+  }
+  auto file = pagComposition->file;
+  if (predictedFile.lock() != file) {
+    // 每个文件只计算一次逐帧的显存预测，计算失败时也不再重复计算。计算需要遍历整个文件，放到
+    // 异步线程进行，避免长模板的首帧卡顿，计算完成之前使用默认的清理阈值。
+    predictedFile = file;
+    memoryPredictor = nullptr;
+    predictorTask = MemoryPredictorTask::MakeAndRun(file);
+  }
+  if (predictorTask != nullptr && !predictorTask->isRunning()) {
+    auto executor = predictorTask->wait();
+    memoryPredictor = static_cast<MemoryPredictorTask*>(executor)->getPredictor();
+    predictorTask = nullptr;
+  }
+  if (memoryPredictor == nullptr) {
+    return;
+  }
+  auto frame = ProgressToFrame(pagComposition->getProgressInternal(), memoryPredictor->duration());
+  // 预测值是按文件原始尺寸计算的，需要换算到当前的渲染尺寸。
+  auto scale = ToTGFX(pagComposition->getTotalMatrixInternal()).getMaxScale();
+  auto memoryScale = static_cast<double>(scale) * static_cast<double>(scale);
+  predictedMemory = static_cast<int64_t>(
+      static_cast<double>(memoryPredictor->memoryAt(frame)) * memoryScale);
+  auto lookAheadFrames = TimeToFrame(DECODING_VISIBLE_DISTANCE, file->frameRate());
+  auto peakMemory = static_cast<double>(memoryPredictor->peakMemoryIn(frame, lookAheadFrames)) *
+                    memoryScale;
+  // 用即将播放的若干帧的显存峰值作为清理阈值，峰值附近不会反复清理重建，峰值过后能及时释放。
+  memoryBudget = static_cast<size_t>(
+      std::min(std::max(peakMemory, static_cast<double>(PURGEABLE_GRAPHICS_MEMORY)),
+               static_cast<double>(MAX_GRAPHICS_MEMORY)));
 }
 
 void RenderCache::attachToContext(tgfx::Context* current, bool forHitTest) {
@@ -222,8 +295,8 @@ void RenderCache::releaseAll() {
   deviceID = 0;
 }
 
-void RenderCache::detachFromContext() {
-  if (hitTestOnly) {
+void RenderCache::detachFromContext(bool clearExpiredCaches) {
+  if (hitTestOnly || !clearExpiredCaches) {
     context = nullptr;
     return;
   }
@@ -247,6 +320,14 @@ Snapshot* RenderCache::getSnapshot(ID assetID) const {
   return nullptr;
 }
 
+Snapshot* RenderCache::findSnapshot(const Picture* image) const {
+  auto snapshot = getSnapshot(image->snapshotID);
+  if (snapshot == nullptr || snapshot->makerKey != image->uniqueKey) {
+    return nullptr;
+  }
+  return snapshot;
+}
+
 Snapshot* RenderCache::makeSnapshot(float scaleFactor, const std::function<Snapshot*()>& maker) {
   if (scaleFactor < SCALE_FACTOR_PRECISION || graphicsMemory >= MAX_GRAPHICS_MEMORY) {
     return nullptr;
@@ -265,12 +346,13 @@ Snapshot* RenderCache::getSnapshot(const Picture* image) {
     return nullptr;
   }
   usedAssets.insert(image->assetID);
+  usedAssets.insert(image->snapshotID);
   auto maxScaleFactor = stage->getAssetMaxScale(image->assetID);
   auto scaleFactor = image->getScaleFactor(maxScaleFactor);
-  auto snapshot = getSnapshot(image->assetID);
+  auto snapshot = getSnapshot(image->snapshotID);
   if (snapshot && (snapshot->makerKey != image->uniqueKey ||
                    fabsf(snapshot->scaleFactor() - scaleFactor) > SCALE_FACTOR_PRECISION)) {
-    removeSnapshot(image->assetID);
+    removeSnapshot(image->snapshotID);
     snapshot = nullptr;
   }
   if (snapshot) {
@@ -282,9 +364,64 @@ Snapshot* RenderCache::getSnapshot(const Picture* image) {
   if (snapshot == nullptr) {
     return nullptr;
   }
-  snapshot->assetID = image->assetID;
+  snapshot->assetID = image->snapshotID;
   snapshot->makerKey = image->uniqueKey;
-  snapshotCaches[image->assetID] = snapshot;
+  snapshotCaches[image->snapshotID] = snapshot;
+  return snapshot;
+}
+
+static Snapshot* MakeMaskSnapshot(RenderCache* cache, const Graphic* mask, float scaleFactor,
+                                  bool alphaOnly) {
+  auto bounds = tgfx::Rect::MakeEmpty();
+  mask->measureBounds(&bounds);
+  if (bounds.isEmpty()) {
+    return nullptr;
+  }
+  // 四周留出一个像素的透明边，保证纹理采样超出遮罩范围时结果为透明。
+  auto width = static_cast<int>(ceilf(bounds.width() * scaleFactor)) + 2;
+  auto height = static_cast<int>(ceilf(bounds.height() * scaleFactor)) + 2;
+  auto surface = tgfx::Surface::Make(cache->getContext(), width, height, alphaOnly);
+  if (surface == nullptr) {
+    surface = tgfx::Surface::Make(cache->getContext(), width, height);
+  }
+  if (surface == nullptr) {
+    return nullptr;
+  }
+  auto canvas = surface->getCanvas();
+  auto matrix = tgfx::Matrix::MakeTrans(1, 1);
+  matrix.preScale(scaleFactor, scaleFactor);
+  matrix.preTranslate(-bounds.x(), -bounds.y());
+  canvas->setMatrix(matrix);
+  mask->draw(canvas, cache);
+  auto drawingMatrix = tgfx::Matrix::I();
+  matrix.invert(&drawingMatrix);
+  return new Snapshot(surface->getTexture(), drawingMatrix);
+}
+
+Snapshot* RenderCache::getMaskSnapshot(ID maskID, uint64_t maskKey, const Graphic* mask,
+                                       float scaleFactor, bool alphaOnly) {
+  if (!_snapshotEnabled || mask == nullptr) {
+    return nullptr;
+  }
+  usedAssets.insert(maskID);
+  auto snapshot = getSnapshot(maskID);
+  if (snapshot && (snapshot->makerKey != maskKey ||
+                   fabsf(snapshot->scaleFactor() - scaleFactor) > SCALE_FACTOR_PRECISION)) {
+    removeSnapshot(maskID);
+    snapshot = nullptr;
+  }
+  if (snapshot) {
+    moveSnapshotToHead(snapshot);
+    return snapshot;
+  }
+  snapshot = makeSnapshot(
+      scaleFactor, [&]() { return MakeMaskSnapshot(this, mask, scaleFactor, alphaOnly); });
+  if (snapshot == nullptr) {
+    return nullptr;
+  }
+  snapshot->assetID = maskID;
+  snapshot->makerKey = maskKey;
+  snapshotCaches[maskID] = snapshot;
   return snapshot;
 }
 
@@ -404,6 +541,7 @@ TextAtlas* RenderCache::getTextAtlas(const TextBlock* textBlock) {
   if (maxScaleFactor < SCALE_FACTOR_PRECISION) {
     return nullptr;
   }
+  TRACE_SPAN("TextAtlas::Make");
   textAtlas = TextAtlas::Make(textBlock, this, maxScaleFactor).release();
   if (textAtlas) {
     graphicsMemory += textAtlas->memoryUsage();
@@ -459,8 +597,9 @@ void RenderCache::clearExpiredSnapshots() {
     }
     snapshot->idleFrames++;
     if (snapshot->idleFrames < PURGEABLE_EXPIRED_FRAME &&
-        graphicsMemory + releaseMemory < PURGEABLE_GRAPHICS_MEMORY) {
-      // 总显存占用未超过20M且所有缓存均未超过10帧未使用，跳过清理。
+        graphicsMemory + releaseMemory < memoryBudget) {
+      // 总显存占用未超过清理阈值且所有缓存均未超过10帧未使用，跳过清理。清理阈值默认为20M，
+      // 有显存预测时取即将播放的若干帧的预测峰值。
       continue;
     }
     releaseMemory += snapshot->memoryUsage();
@@ -480,7 +619,8 @@ void RenderCache::prepareImage(ID assetID, std::shared_ptr<tgfx::Image> image) {
   if (imageTasks.count(assetID) != 0 || snapshotCaches.count(assetID) != 0) {
     return;
   }
-  auto task = ImageTask::MakeAndRun(std::move(image), stage->getFileFromReferenceMap(assetID));
+  auto task = ImageTask::MakeAndRun(std::move(image), stage->getFileFromReferenceMap(assetID),
+                                    getImageDecodingScale(assetID));
   if (task) {
     imageTasks[assetID] = task;
   }
@@ -499,6 +639,15 @@ std::shared_ptr<tgfx::TextureBuffer> RenderCache::getImageBuffer(ID assetID) {
   return {};
 }
 
+float RenderCache::getImageDecodingScale(ID assetID) {
+  auto scaleFactor = stage->getAssetMaxScale(assetID);
+  if (scaleFactor < SCALE_FACTOR_PRECISION || scaleFactor > 1.0f) {
+    // Decode at full resolution if the max scale factor of the asset is unknown.
+    return 1.0f;
+  }
+  return scaleFactor;
+}
+
 void RenderCache::clearExpiredBitmaps() {
   std::vector<ID> expiredBitmaps = {};
   for (auto& item : imageTasks) {
@@ -641,6 +790,30 @@ LayerStylesFilter* RenderCache::getLayerStylesFilter(Layer* layer) {
   return filter;
 }
 
+void RenderCache::warmUpFilters(PAGLayer* pagLayer) {
+  auto layer = pagLayer->layer;
+  for (auto effect : layer->effects) {
+    getFilterCache(effect);
+  }
+  if (!layer->layerStyles.empty()) {
+    getLayerStylesFilter(layer);
+    for (auto layerStyle : layer->layerStyles) {
+      getFilterCache(layerStyle);
+    }
+  }
+  if (layer->motionBlur) {
+    getMotionBlurFilter();
+  }
+  if (pagLayer->_trackMatteLayer != nullptr) {
+    warmUpFilters(pagLayer->_trackMatteLayer.get());
+  }
+  if (pagLayer->layerType() == LayerType::PreCompose) {
+    for (auto& childLayer : static_cast<PAGComposition*>(pagLayer)->layers) {
+      warmUpFilters(childLayer.get());
+    }
+  }
+}
+
 void RenderCache::clearFilterCache(ID uniqueID) {
   auto result = filterCaches.find(uniqueID);
   if (result != filterCaches.end()) {
@@ -21,6 +21,7 @@
 #include <list>
 #include <memory>
 #include <unordered_set>
+#include "MemoryPredictor.h"
 #include "TextAtlas.h"
 #include "TextBlock.h"
 #include "pag/file.h"
@@ -53,7 +54,12 @@ class RenderCache : public Performance {
 
   void attachToContext(tgfx::Context* current, bool forHitTest = false);
 
-  void detachFromContext();
+  /**
+   * Detaches from the current context. The caches not used since the last frame are cleared and
+   * the unused GPU resources are purged unless clearExpiredCaches is false, which should be used
+   * when nothing is rendered in between, for example, during warming up.
+   */
+  void detachFromContext(bool clearExpiredCaches = true);
 
   /**
    * Returns the total memory usage of this cache.
@@ -62,6 +68,23 @@ class RenderCache : public Performance {
     return graphicsMemory;
   }
 
+  /**
+   * Returns the graphics memory predicted for the current frame, scaled to the current rendering
+   * size. Returns 0 if there is no prediction available, e.g. the root composition is not a
+   * PAGFile.
+   */
+  int64_t predictedMemoryUsage() const {
+    return predictedMemory;
+  }
+
+  /**
+   * Returns the memory budget used to decide whether the unused caches should be purged. It is
+   * the predicted peak memory of the upcoming frames if there is a prediction available.
+   */
+  size_t purgeableMemory() const {
+    return memoryBudget;
+  }
+
   /**
    * Returns the GPU context associated with this cache.
    */
@@ -92,6 +115,12 @@ class RenderCache : public Performance {
    */
   Snapshot* getSnapshot(ID assetID) const;
 
+  /**
+   * Returns the snapshot cache of specified Image if it was made from the same content. Returns
+   * null if there is no matching cache available. This never creates a new cache.
+   */
+  Snapshot* findSnapshot(const Picture* image) const;
+
   /**
    * Returns a snapshot cache of specified Image. If there is no associated cache available,
    * a new cache will be created by the image. Returns null if the image fails to make a
@@ -106,6 +135,14 @@ class RenderCache : public Performance {
 
   Snapshot* getSnapshot(const Shape* shape);
 
+  /**
+   * Returns a snapshot cache of the specified mask graphic rasterized at the scaleFactor. The
+   * cache is reused until the maskKey or the scaleFactor changes. Returns null if the mask fails to
+   * make a new snapshot.
+   */
+  Snapshot* getMaskSnapshot(ID maskID, uint64_t maskKey, const Graphic* mask, float scaleFactor,
+                            bool alphaOnly);
+
   TextAtlas* getTextAtlas(const TextBlock* textBlock);
 
   /**
@@ -119,6 +156,13 @@ class RenderCache : public Performance {
    */
   std::shared_ptr<tgfx::TextureBuffer> getImageBuffer(ID assetID);
 
+  /**
+   * Returns the scale factor to decode the image of specified asset id, which ranges from 0.0 to
+   * 1.0. Images that are displayed at a fraction of their size are decoded at a reduced resolution
+   * to save the decoding time and graphics memory.
+   */
+  float getImageDecodingScale(ID assetID);
+
   uint32_t getContentVersion() const;
 
   bool videoEnabled() const;
@@ -137,6 +181,12 @@ class RenderCache : public Performance {
 
   LayerStylesFilter* getLayerStylesFilter(Layer* layer);
 
+  /**
+   * Creates the filters of all effects, layer styles and motion blurs used by the specified layer
+   * and its descendants, which compiles their GPU programs ahead of the first drawing.
+   */
+  void warmUpFilters(PAGLayer* pagLayer);
+
   void recordImageDecodingTime(int64_t decodingTime);
 
   void recordTextureUploadingTime(int64_t time);
@@ -153,6 +203,11 @@ class RenderCache : public Performance {
   int64_t lastTimestamp = 0;
   bool hitTestOnly = false;
   size_t graphicsMemory = 0;
+  int64_t predictedMemory = 0;
+  size_t memoryBudget = 0;
+  std::weak_ptr<File> predictedFile = {};
+  std::shared_ptr<Task> predictorTask = nullptr;
+  std::unique_ptr<MemoryPredictor> memoryPredictor = nullptr;
   bool _videoEnabled = true;
   bool _snapshotEnabled = true;
   std::unordered_set<ID> usedAssets = {};
@@ -165,6 +220,9 @@ class RenderCache : public Performance {
   MotionBlurFilter* motionBlurFilter = nullptr;
   std::unordered_map<ID, std::unordered_map<tgfx::Path, Snapshot*, tgfx::PathHash>> pathCaches;
 
+  // memory prediction:
+  void updateMemoryBudget();
+
   // bitmap caches:
   void clearExpiredBitmaps();
 
@@ -51,7 +51,7 @@ class TextBlock {
     return _maxScale;
   }
 
-  std::vector<std::vector<GlyphHandle>> lines() const {
+  const std::vector<std::vector<GlyphHandle>>& lines() const {
     return _lines;
   }
 
@@ -18,6 +18,7 @@
 
 #include "TextContentCache.h"
 #include "TextContent.h"
+#include "TextLayoutCache.h"
 #include "base/utils/TGFXCast.h"
 #include "rendering/graphics/Picture.h"
 #include "rendering/graphics/Shape.h"
@@ -83,8 +84,9 @@ void TextContentCache::initTextGlyphs(const std::vector<std::vector<GlyphHandle>
     return;
   }
   auto addFunc = [&](TextDocument* textDocument, TextPathOptions* pathOptions) {
-    auto [lines, bounds] = GetLines(textDocument, pathOptions);
-    textBlocks[textDocument] = std::make_shared<TextBlock>(getCacheID(), lines, scale, &bounds);
+    auto layout = TextLayoutCache::GetLayout(textDocument, pathOptions);
+    textBlocks[textDocument] =
+        std::make_shared<TextBlock>(getCacheID(), layout->lines, scale, &layout->bounds);
   };
   if (sourceText->animatable()) {
     auto animatableProperty = reinterpret_cast<AnimatableProperty<TextDocumentHandle>*>(sourceText);
@@ -116,21 +118,37 @@ ID TextContentCache::getCacheID() const {
 
 static std::vector<std::vector<GlyphHandle>> CopyLines(
     const std::shared_ptr<TextBlock>& textBlock) {
+  auto& lines = textBlock->lines();
+  size_t glyphCount = 0;
+  for (const auto& line : lines) {
+    glyphCount += line.size();
+  }
+  // 每帧复制的字形都存放在同一块连续内存中，各个 GlyphHandle 通过 shared_ptr 的别名构造共享这块内存
+  // 的引用计数，避免逐个字形分配内存。预先 reserve 保证 push_back 不会导致已有字形的地址失效。
+  auto glyphStorage = std::make_shared<std::vector<Glyph>>();
+  glyphStorage->reserve(glyphCount);
   std::vector<std::vector<GlyphHandle>> glyphLines;
-  for (const auto& line : textBlock->lines()) {
+  glyphLines.reserve(lines.size());
+  for (const auto& line : lines) {
     std::vector<GlyphHandle> glyphLine;
     glyphLine.reserve(line.size());
     for (const auto& glyph : line) {
-      glyphLine.emplace_back(std::make_shared<Glyph>(*glyph));
+      glyphStorage->push_back(*glyph);
+      glyphLine.emplace_back(glyphStorage, &glyphStorage->back());
     }
-    glyphLines.emplace_back(glyphLine);
+    glyphLines.emplace_back(std::move(glyphLine));
   }
   return glyphLines;
 }
 
 std::pair<std::vector<GlyphHandle>, std::vector<GlyphHandle>> GetGlyphs(
     const std::vector<std::vector<GlyphHandle>>& glyphLines) {
+  size_t glyphCount = 0;
+  for (auto& line : glyphLines) {
+    glyphCount += line.size();
+  }
   std::vector<GlyphHandle> simpleGlyphs = {};
+  simpleGlyphs.reserve(glyphCount);
   std::vector<GlyphHandle> colorGlyphs = {};
   for (auto& line : glyphLines) {
     for (auto& glyph : line) {
@@ -0,0 +1,121 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2021 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "TextLayoutCache.h"
+#include "rendering/FontManager.h"
+#include "rendering/renderers/TextRenderer.h"
+
+namespace pag {
+#define MAX_TEXT_LAYOUT_COUNT 256
+
+static void WriteString(tgfx::BytesKey* bytesKey, const std::string& value) {
+  bytesKey->write(static_cast<uint32_t>(value.size()));
+  size_t index = 0;
+  while (index < value.size()) {
+    uint8_t bytes[4] = {0, 0, 0, 0};
+    for (size_t i = 0; i < 4 && index < value.size(); i++, index++) {
+      bytes[i] = static_cast<uint8_t>(value[index]);
+    }
+    bytesKey->write(bytes);
+  }
+}
+
+static void WriteColor(tgfx::BytesKey* bytesKey, const Color& color) {
+  uint8_t values[4] = {color.red, color.green, color.blue, 0};
+  bytesKey->write(values);
+}
+
+static tgfx::BytesKey ComputeLayoutKey(const TextDocument* textDocument,
+                                       const TextPathOptions* pathOptions) {
+  tgfx::BytesKey bytesKey = {};
+  // The background, the time range and the comment do not affect the layout.
+  uint8_t flags[4] = {
+      static_cast<uint8_t>(textDocument->applyFill | (textDocument->applyStroke << 1) |
+                           (textDocument->boxText << 2) | (textDocument->fauxBold << 3) |
+                           (textDocument->fauxItalic << 4) | (textDocument->strokeOverFill << 5) |
+                           ((pathOptions != nullptr) << 6)),
+      textDocument->justification, textDocument->direction, 0};
+  bytesKey.write(flags);
+  bytesKey.write(textDocument->baselineShift);
+  bytesKey.write(textDocument->boxTextPos.x);
+  bytesKey.write(textDocument->boxTextPos.y);
+  bytesKey.write(textDocument->boxTextSize.x);
+  bytesKey.write(textDocument->boxTextSize.y);
+  bytesKey.write(textDocument->firstBaseLine);
+  bytesKey.write(textDocument->fontSize);
+  bytesKey.write(textDocument->strokeWidth);
+  bytesKey.write(textDocument->leading);
+  bytesKey.write(textDocument->tracking);
+  WriteColor(&bytesKey, textDocument->fillColor);
+  WriteColor(&bytesKey, textDocument->strokeColor);
+  // Registering fonts or changing the fallback fonts may resolve the same names to other glyphs.
+  auto typeface =
+      FontManager::GetTypefaceWithoutFallback(textDocument->fontFamily, textDocument->fontStyle);
+  bytesKey.write(typeface ? typeface->uniqueID() : 0);
+  bytesKey.write(FontManager::GetFallbackFontVersion());
+  WriteString(&bytesKey, textDocument->fontFamily);
+  WriteString(&bytesKey, textDocument->fontStyle);
+  WriteString(&bytesKey, textDocument->text);
+  return bytesKey;
+}
+
+TextLayoutCache* TextLayoutCache::Get() {
+  static auto& cache = *new TextLayoutCache();
+  return &cache;
+}
+
+std::shared_ptr<TextLayoutResult> TextLayoutCache::GetLayout(const TextDocument* textDocument,
+                                                             const TextPathOptions* pathOptions) {
+  auto key = ComputeLayoutKey(textDocument, pathOptions);
+  auto cache = Get();
+  auto layout = cache->find(key);
+  if (layout != nullptr) {
+    return layout;
+  }
+  layout = std::make_shared<TextLayoutResult>();
+  auto result = GetLines(textDocument, pathOptions);
+  layout->lines = std::move(result.first);
+  layout->bounds = result.second;
+  cache->add(key, layout);
+  return layout;
+}
+
+std::shared_ptr<TextLayoutResult> TextLayoutCache::find(const tgfx::BytesKey& key) {
+  std::lock_guard<std::mutex> autoLock(locker);
+  auto result = entryMap.find(key);
+  if (result == entryMap.end()) {
+    return nullptr;
+  }
+  // Moves the entry to the end of the list as the most recently used one.
+  entries.splice(entries.end(), entries, result->second);
+  return result->second->layout;
+}
+
+void TextLayoutCache::add(const tgfx::BytesKey& key, std::shared_ptr<TextLayoutResult> layout) {
+  std::lock_guard<std::mutex> autoLock(locker);
+  if (entryMap.count(key) > 0) {
+    return;
+  }
+  if (entries.size() >= MAX_TEXT_LAYOUT_COUNT) {
+    entryMap.erase(entries.front().key);
+    entries.pop_front();
+  }
+  entries.push_back({key, std::move(layout)});
+  entryMap[key] = std::prev(entries.end());
+}
+}  // namespace pag
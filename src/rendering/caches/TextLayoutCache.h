@@ -0,0 +1,66 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2021 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include "pag/file.h"
+#include "rendering/graphics/Glyph.h"
+#include "tgfx/core/BytesKey.h"
+
+namespace pag {
+/**
+ * TextLayoutResult holds the glyph lines and the text bounds produced by laying out a
+ * TextDocument. The glyphs are shared by all the TextBlocks created from the same layout and must
+ * not be modified.
+ */
+struct TextLayoutResult {
+  std::vector<std::vector<GlyphHandle>> lines = {};
+  tgfx::Rect bounds = tgfx::Rect::MakeEmpty();
+};
+
+/**
+ * TextLayoutCache keeps the recently computed text layouts, keyed by the layout-relevant fields of
+ * TextDocuments, so that identical text documents from different keyframes, layers or files are
+ * only laid out once.
+ */
+class TextLayoutCache {
+ public:
+  /**
+   * Returns the layout of the specified text document, computing it if it is not cached yet.
+   */
+  static std::shared_ptr<TextLayoutResult> GetLayout(const TextDocument* textDocument,
+                                                     const TextPathOptions* pathOptions);
+
+ private:
+  struct Entry {
+    tgfx::BytesKey key = {};
+    std::shared_ptr<TextLayoutResult> layout = nullptr;
+  };
+
+  std::mutex locker = {};
+  std::list<Entry> entries = {};
+  std::unordered_map<tgfx::BytesKey, std::list<Entry>::iterator, tgfx::BytesHasher> entryMap = {};
+
+  static TextLayoutCache* Get();
+  std::shared_ptr<TextLayoutResult> find(const tgfx::BytesKey& key);
+  void add(const tgfx::BytesKey& key, std::shared_ptr<TextLayoutResult> layout);
+};
+}  // namespace pag
@@ -55,8 +55,15 @@ static const char MOTIONBLUR_FRAGMENT_SHADER[] = R"(
         uniform sampler2D uTextureInput;
         uniform float uVelCenter;
         uniform float maxDistance;
-        const int kSamplesPerFrame = 37;
+        uniform int uSampleCount;
+        const int kMaxSamplesPerFrame = 37;
         void main() {
+            if (uSampleCount <= 1) {
+                // The bounds are enlarged by TransformBounds(), keep the margin transparent.
+                vec2 inside = step(vec2(0.0), vertexColor) * step(vertexColor, vec2(1.0));
+                gl_FragColor = texture2D(uTextureInput, vertexColor) * inside.x * inside.y;
+                return;
+            }
             vec2 velocity = vCurrPosition.xy - vPrevPosition.xy;
             float distance = length(velocity);
             velocity *= (min(distance, maxDistance) / distance);
@@ -67,8 +74,11 @@ static const char MOTIONBLUR_FRAGMENT_SHADER[] = R"(
             float reachedEdgeCount = 0.0;
 
             vec4 result = texture2D(uTextureInput, vertexColor);
-            for (int i = 1; i < kSamplesPerFrame; ++i) {
-                target = vertexColor + velocity * (float(i) / float(kSamplesPerFrame - 1) - uVelCenter);
+            for (int i = 1; i < kMaxSamplesPerFrame; ++i) {
+                if (i >= uSampleCount) {
+                    break;
+                }
+                target = vertexColor + velocity * (float(i) / float(uSampleCount - 1) - uVelCenter);
 
                 edgeDetect = abs(step(vec2(1.0), target) - vec2(1.0)) * step(vec2(0.0), target);
                 edgeDetectValue = edgeDetect.x * edgeDetect.y;
@@ -77,10 +87,27 @@ static const char MOTIONBLUR_FRAGMENT_SHADER[] = R"(
 
                 result += texture2D(uTextureInput, target) * edgeDetectValue;
             }
-            gl_FragColor = (reachedEdgeCount < float(kSamplesPerFrame) - 1.0) ? result / float(kSamplesPerFrame) : vec4(0.0);
+            gl_FragColor = (reachedEdgeCount < float(uSampleCount) - 1.0) ? result / float(uSampleCount) : vec4(0.0);
         }
     )";
 
+/**
+ * 根据像素位移选取采样档位，档位固定可以让相近速度的绘制保持稳定的采样数。位移小于半个像素时不需要模糊，
+ * 直接采样一次即可。
+ */
+static int ComputeSampleCount(float pixelDistance) {
+  if (pixelDistance < 0.5f) {
+    return 1;
+  }
+  if (pixelDistance <= 8.0f) {
+    return 9;
+  }
+  if (pixelDistance <= 16.0f) {
+    return 17;
+  }
+  return 37;
+}
+
 void MotionBlurFilter::TransformBounds(tgfx::Rect* bounds, const tgfx::Point&, Layer* layer,
                                        Frame layerFrame) {
   auto contentFrame = layerFrame - layer->startTime;
@@ -113,6 +140,7 @@ void MotionBlurFilter::onPrepareProgram(tgfx::Context* context, unsigned int pro
   transformHandle = gl->getUniformLocation(program, "uTransform");
   velCenterHandle = gl->getUniformLocation(program, "uVelCenter");
   maxDistanceHandle = gl->getUniformLocation(program, "maxDistance");
+  sampleCountHandle = gl->getUniformLocation(program, "uSampleCount");
 }
 
 bool MotionBlurFilter::updateLayer(Layer* targetLayer, Frame layerFrame) {
@@ -123,8 +151,36 @@ bool MotionBlurFilter::updateLayer(Layer* targetLayer, Frame layerFrame) {
   return previousMatrix != currentMatrix;
 }
 
+float MotionBlurFilter::computePixelDistance(float width, float height,
+                                            const tgfx::Point& filterScale) const {
+  if (width <= 0 || height <= 0) {
+    return 0;
+  }
+  auto maxDistance = (MOTION_BLUR_SCALE_FACTOR - 1.0f) * 0.5f;
+  tgfx::Point corners[4] = {{0, 0}, {width, 0}, {0, height}, {width, height}};
+  float result = 0;
+  for (auto& corner : corners) {
+    tgfx::Point current = {};
+    tgfx::Point previous = {};
+    currentMatrix.mapPoints(&current, &corner, 1);
+    previousMatrix.mapPoints(&previous, &corner, 1);
+    // 与 Fragment Shader 保持一致：先在纹理坐标系下把速度限制到 maxDistance 以内，再换算成像素。
+    auto dx = (current.x - previous.x) / width;
+    auto dy = (current.y - previous.y) / height;
+    auto distance = sqrtf(dx * dx + dy * dy);
+    if (distance > maxDistance) {
+      dx *= maxDistance / distance;
+      dy *= maxDistance / distance;
+    }
+    auto pixelX = dx * width * filterScale.x;
+    auto pixelY = dy * height * filterScale.y;
+    result = std::max(result, sqrtf(pixelX * pixelX + pixelY * pixelY));
+  }
+  return result;
+}
+
 void MotionBlurFilter::onUpdateParams(tgfx::Context* context, const tgfx::Rect& contentBounds,
-                                      const tgfx::Point&) {
+                                      const tgfx::Point& filterScale) {
   auto width = static_cast<int>(contentBounds.width());
   auto height = static_cast<int>(contentBounds.height());
   auto origin = tgfx::ImageOrigin::TopLeft;
@@ -141,6 +197,9 @@ void MotionBlurFilter::onUpdateParams(tgfx::Context* context, const tgfx::Rect&
   gl->uniformMatrix3fv(transformHandle, 1, GL_FALSE, currentGLMatrix.data());
   gl->uniform1f(velCenterHandle, scaling ? 0.0f : 0.5f);
   gl->uniform1f(maxDistanceHandle, (MOTION_BLUR_SCALE_FACTOR - 1.0) * 0.5f);
+  auto pixelDistance = computePixelDistance(contentBounds.width(), contentBounds.height(),
+                                            filterScale);
+  gl->uniform1i(sampleCountHandle, ComputeSampleCount(pixelDistance));
 }
 
 std::vector<tgfx::Point> MotionBlurFilter::computeVertices(const tgfx::Rect& inputBounds,
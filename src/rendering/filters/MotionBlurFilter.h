@@ -53,5 +53,12 @@ class MotionBlurFilter : public LayerFilter {
   int transformHandle = 0;
   int velCenterHandle = 0;
   int maxDistanceHandle = 0;
+  int sampleCountHandle = 0;
+
+  /**
+   * Returns the maximum displacement in pixels of the content corners between the previous and the
+   * current frame, clamped the same way as the fragment shader does.
+   */
+  float computePixelDistance(float width, float height, const tgfx::Point& filterScale) const;
 };
 }  // namespace pag
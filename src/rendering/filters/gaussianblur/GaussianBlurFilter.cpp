@@ -50,17 +50,43 @@ void GaussianBlurFilter::draw(tgfx::Context* context, const FilterSource* source
         tgfx::Rect::MakeWH(static_cast<float>(source->width), static_cast<float>(source->height));
   }
   auto blurFilter = tgfx::ImageFilter::Blur(blurrinessX, blurrinessY, tileMode, cropRect);
-  auto renderTarget = tgfx::GLRenderTarget::MakeFrom(context, target->frameBuffer, target->width,
-                                                     target->height, tgfx::ImageOrigin::TopLeft);
-  auto targetSurface = tgfx::Surface::MakeFrom(renderTarget);
-  auto targetCanvas = targetSurface->getCanvas();
-  auto texture = tgfx::GLTexture::MakeFrom(context, source->sampler, source->width, source->height,
-                                           tgfx::ImageOrigin::TopLeft);
+  auto surface = getTargetSurface(context, target);
+  auto texture = getSourceTexture(context, source);
+  if (surface == nullptr || texture == nullptr) {
+    return;
+  }
+  auto targetCanvas = surface->getCanvas();
   targetCanvas->save();
   targetCanvas->setMatrix(ToMatrix(target));
   tgfx::Paint paint;
   paint.setImageFilter(blurFilter);
-  targetCanvas->drawTexture(texture.get(), &paint);
+  targetCanvas->drawTexture(texture, &paint);
   targetCanvas->restore();
 }
+
+tgfx::Surface* GaussianBlurFilter::getTargetSurface(tgfx::Context* context,
+                                                    const FilterTarget* target) {
+  // FilterBuffer 在帧间大多是复用的，包装对象也跟着复用，避免每帧重新创建 Surface 和 Canvas。
+  if (targetSurface == nullptr || targetSurface->getContext() != context ||
+      targetFrameBufferID != target->frameBuffer.id || targetSurface->width() != target->width ||
+      targetSurface->height() != target->height) {
+    auto renderTarget =
+        tgfx::GLRenderTarget::MakeFrom(context, target->frameBuffer, target->width,
+                                       target->height, tgfx::ImageOrigin::TopLeft);
+    targetSurface = tgfx::Surface::MakeFrom(renderTarget);
+    targetFrameBufferID = target->frameBuffer.id;
+  }
+  return targetSurface.get();
+}
+
+tgfx::Texture* GaussianBlurFilter::getSourceTexture(tgfx::Context* context,
+                                                    const FilterSource* source) {
+  if (sourceTexture == nullptr || sourceTexture->getContext() != context ||
+      sourceTexture->glSampler().id != source->sampler.id ||
+      sourceTexture->width() != source->width || sourceTexture->height() != source->height) {
+    sourceTexture = tgfx::GLTexture::MakeFrom(context, source->sampler, source->width,
+                                              source->height, tgfx::ImageOrigin::TopLeft);
+  }
+  return sourceTexture.get();
+}
 }  // namespace pag
@@ -34,5 +34,12 @@ class GaussianBlurFilter : public LayerFilter {
 
  private:
   Effect* effect = nullptr;
+  unsigned targetFrameBufferID = 0;
+  std::shared_ptr<tgfx::Surface> targetSurface = nullptr;
+  std::shared_ptr<tgfx::GLTexture> sourceTexture = nullptr;
+
+  tgfx::Surface* getTargetSurface(tgfx::Context* context, const FilterTarget* target);
+
+  tgfx::Texture* getSourceTexture(tgfx::Context* context, const FilterSource* source);
 };
 }  // namespace pag
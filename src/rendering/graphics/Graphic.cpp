@@ -17,6 +17,7 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "Graphic.h"
+#include <algorithm>
 #include "base/utils/MatrixUtil.h"
 #include "tgfx/gpu/Canvas.h"
 
@@ -69,7 +70,7 @@ std::shared_ptr<Graphic> Graphic::MakeCompose(std::shared_ptr<Graphic> graphic,
       return result;
     }
   }
-  return std::make_shared<MatrixGraphic>(graphic, matrix);
+  return std::make_shared<MatrixGraphic>(std::move(graphic), matrix);
 }
 
 void MatrixGraphic::measureBounds(tgfx::Rect* bounds) const {
@@ -135,20 +136,16 @@ class LayerGraphic : public ComposeGraphic {
 };
 
 std::shared_ptr<Graphic> Graphic::MakeCompose(std::vector<std::shared_ptr<Graphic>> contents) {
-  std::vector<std::shared_ptr<Graphic>> graphics = {};
-  for (auto& content : contents) {
-    if (content == nullptr) {
-      continue;
-    }
-    graphics.push_back(content);
-  }
-  if (graphics.empty()) {
+  // Filters the contents in place and moves them into the LayerGraphic, callers passing an rvalue
+  // get no extra vector allocation or reference count traffic.
+  contents.erase(std::remove(contents.begin(), contents.end(), nullptr), contents.end());
+  if (contents.empty()) {
     return nullptr;
   }
-  if (graphics.size() == 1) {
-    return graphics[0];
+  if (contents.size() == 1) {
+    return std::move(contents[0]);
   }
-  return std::make_shared<LayerGraphic>(graphics);
+  return std::make_shared<LayerGraphic>(std::move(contents));
 }
 
 void LayerGraphic::measureBounds(tgfx::Rect* bounds) const {
@@ -242,7 +239,7 @@ std::shared_ptr<Graphic> Graphic::MakeCompose(std::shared_ptr<Graphic> graphic,
       return result;
     }
   }
-  return std::make_shared<ModifierGraphic>(graphic, modifier);
+  return std::make_shared<ModifierGraphic>(std::move(graphic), std::move(modifier));
 }
 
 void ModifierGraphic::measureBounds(tgfx::Rect* bounds) const {
@@ -0,0 +1,71 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2021 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "HitTestMask.h"
+#include "tgfx/gpu/Surface.h"
+
+namespace pag {
+// 遮罩的最大边长，超出时按比例缩小，单个遮罩最多占用 64KB 内存。
+#define MAX_HIT_TEST_MASK_SIZE 256
+
+std::unique_ptr<HitTestMask> HitTestMask::Make(
+    tgfx::Context* context, const tgfx::Rect& bounds,
+    const std::function<void(tgfx::Canvas*)>& drawContent) {
+  if (context == nullptr || bounds.isEmpty()) {
+    return nullptr;
+  }
+  auto maxLength = std::max(bounds.width(), bounds.height());
+  auto scale = std::min(1.0f, MAX_HIT_TEST_MASK_SIZE / maxLength);
+  auto width = std::max(static_cast<int>(ceilf(bounds.width() * scale)), 1);
+  auto height = std::max(static_cast<int>(ceilf(bounds.height() * scale)), 1);
+  auto surface = tgfx::Surface::Make(context, width, height, true);
+  if (surface == nullptr) {
+    surface = tgfx::Surface::Make(context, width, height);
+  }
+  if (surface == nullptr) {
+    return nullptr;
+  }
+  auto canvas = surface->getCanvas();
+  auto matrix = tgfx::Matrix::MakeScale(scale);
+  matrix.preTranslate(-bounds.x(), -bounds.y());
+  canvas->setMatrix(matrix);
+  drawContent(canvas);
+  auto mask = std::unique_ptr<HitTestMask>(new HitTestMask());
+  mask->pixels.resize(static_cast<size_t>(width * height));
+  auto info = tgfx::ImageInfo::Make(width, height, tgfx::ColorType::ALPHA_8);
+  if (!surface->readPixels(info, mask->pixels.data())) {
+    return nullptr;
+  }
+  mask->bounds = bounds;
+  mask->scale = scale;
+  mask->width = width;
+  mask->height = height;
+  return mask;
+}
+
+bool HitTestMask::hitTest(float x, float y) const {
+  if (!bounds.contains(x, y)) {
+    return false;
+  }
+  auto column = static_cast<int>((x - bounds.x()) * scale);
+  auto row = static_cast<int>((y - bounds.y()) * scale);
+  column = std::min(std::max(column, 0), width - 1);
+  row = std::min(std::max(row, 0), height - 1);
+  return pixels[static_cast<size_t>(row * width + column)] > 0;
+}
+}  // namespace pag
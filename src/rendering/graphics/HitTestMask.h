@@ -0,0 +1,54 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2021 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <functional>
+#include <vector>
+#include "tgfx/gpu/Canvas.h"
+
+namespace pag {
+/**
+ * HitTestMask keeps a downsampled copy of the alpha channel of some content, so that pixel hit
+ * testing can be answered on the CPU instead of reading pixels back from the GPU for every query.
+ */
+class HitTestMask {
+ public:
+  /**
+   * Renders the content drawn by the drawContent callback into a downsampled alpha surface and
+   * reads it back. The bounds is in the coordinate space of the content. Returns nullptr if the
+   * bounds is empty or the surface can not be created.
+   */
+  static std::unique_ptr<HitTestMask> Make(
+      tgfx::Context* context, const tgfx::Rect& bounds,
+      const std::function<void(tgfx::Canvas*)>& drawContent);
+
+  /**
+   * Returns true if the pixel at the specified point is not fully transparent. The point is in the
+   * coordinate space of the content.
+   */
+  bool hitTest(float x, float y) const;
+
+ private:
+  tgfx::Rect bounds = tgfx::Rect::MakeEmpty();
+  float scale = 1.0f;
+  int width = 0;
+  int height = 0;
+  std::vector<uint8_t> pixels = {};
+};
+}  // namespace pag
@@ -21,6 +21,7 @@
 #include "base/utils/MatrixUtil.h"
 #include "base/utils/TGFXCast.h"
 #include "base/utils/UniqueID.h"
+#include "rendering/caches/RenderCache.h"
 #include "rendering/utils/SurfaceUtil.h"
 #include "tgfx/core/BlendMode.h"
 #include "tgfx/gpu/Surface.h"
@@ -97,8 +98,10 @@ class ClipModifier : public Modifier {
 
 class MaskModifier : public Modifier {
  public:
-  MaskModifier(std::shared_ptr<Graphic> mask, bool inverted, bool useLuma)
-      : mask(std::move(mask)), inverted(inverted), useLuma(useLuma) {
+  MaskModifier(std::shared_ptr<Graphic> mask, bool inverted, bool useLuma, ID maskID,
+               uint64_t maskKey)
+      : mask(std::move(mask)), inverted(inverted), useLuma(useLuma), maskID(maskID),
+        maskKey(maskKey) {
   }
 
   ID type() const override {
@@ -132,6 +135,11 @@ class MaskModifier : public Modifier {
   std::shared_ptr<Graphic> mask = nullptr;
   bool inverted = false;
   bool useLuma = false;
+  ID maskID = 0;
+  uint64_t maskKey = 0;
+
+  std::shared_ptr<tgfx::Shader> makeMaskShader(RenderCache* cache, tgfx::Surface* contentSurface,
+                                               const tgfx::Matrix& contentMatrix) const;
 };
 
 //================================================================================
@@ -152,7 +160,7 @@ std::shared_ptr<Modifier> Modifier::MakeClip(const tgfx::Path& clip) {
 }
 
 std::shared_ptr<Modifier> Modifier::MakeMask(std::shared_ptr<Graphic> graphic, bool inverted,
-                                             bool useLuma) {
+                                             bool useLuma, ID maskID, uint64_t maskKey) {
   if (graphic == nullptr && inverted) {
     // 返回空，表示保留目标对象的全部内容。
     return nullptr;
@@ -164,7 +172,7 @@ std::shared_ptr<Modifier> Modifier::MakeMask(std::shared_ptr<Graphic> graphic, b
     }
     return Modifier::MakeClip(clipPath);
   }
-  return std::make_shared<MaskModifier>(graphic, inverted, useLuma);
+  return std::make_shared<MaskModifier>(graphic, inverted, useLuma, maskID, maskKey);
 }
 
 //================================================================================
@@ -269,19 +277,7 @@ void MaskModifier::applyToGraphic(tgfx::Canvas* canvas, RenderCache* cache,
   auto contentCanvas = contentSurface->getCanvas();
   auto contentMatrix = contentCanvas->getMatrix();
   graphic->draw(contentCanvas, cache);
-  auto maskSurface = tgfx::Surface::Make(contentSurface->getContext(), contentSurface->width(),
-                                         contentSurface->height(), !useLuma);
-  if (maskSurface == nullptr) {
-    maskSurface = tgfx::Surface::Make(contentSurface->getContext(), contentSurface->width(),
-                                      contentSurface->height());
-  }
-  if (maskSurface == nullptr) {
-    return;
-  }
-  auto maskCanvas = maskSurface->getCanvas();
-  maskCanvas->setMatrix(contentMatrix);
-  mask->draw(maskCanvas, cache);
-  auto shader = tgfx::Shader::MakeTextureShader(maskSurface->getTexture());
+  auto shader = makeMaskShader(cache, contentSurface.get(), contentMatrix);
   if (shader == nullptr) {
     return;
   }
@@ -299,4 +295,35 @@ void MaskModifier::applyToGraphic(tgfx::Canvas* canvas, RenderCache* cache,
   canvas->drawTexture(texture.get(), &paint);
   canvas->restore();
 }
+
+std::shared_ptr<tgfx::Shader> MaskModifier::makeMaskShader(
+    RenderCache* cache, tgfx::Surface* contentSurface, const tgfx::Matrix& contentMatrix) const {
+  if (maskID > 0) {
+    // 遮罩内容静态时复用缓存的遮罩纹理，省去每帧的离屏绘制。
+    auto scaleFactor = GetMaxScaleFactor(contentMatrix);
+    auto snapshot = cache->getMaskSnapshot(maskID, maskKey, mask.get(), scaleFactor, !useLuma);
+    if (snapshot != nullptr) {
+      auto shader = tgfx::Shader::MakeTextureShader(snapshot->getTexture());
+      if (shader == nullptr) {
+        return nullptr;
+      }
+      auto matrix = contentMatrix;
+      matrix.preConcat(snapshot->getMatrix());
+      return shader->makeWithPreLocalMatrix(matrix);
+    }
+  }
+  auto maskSurface = tgfx::Surface::Make(contentSurface->getContext(), contentSurface->width(),
+                                         contentSurface->height(), !useLuma);
+  if (maskSurface == nullptr) {
+    maskSurface = tgfx::Surface::Make(contentSurface->getContext(), contentSurface->width(),
+                                      contentSurface->height());
+  }
+  if (maskSurface == nullptr) {
+    return nullptr;
+  }
+  auto maskCanvas = maskSurface->getCanvas();
+  maskCanvas->setMatrix(contentMatrix);
+  mask->draw(maskCanvas, cache);
+  return tgfx::Shader::MakeTextureShader(maskSurface->getTexture());
+}
 }  // namespace pag
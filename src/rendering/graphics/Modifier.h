@@ -18,6 +18,7 @@
 
 #pragma once
 
+#include "pag/types.h"
 #include "tgfx/core/BlendMode.h"
 #include "tgfx/core/Path.h"
 #include "tgfx/gpu/Canvas.h"
@@ -31,8 +32,12 @@ class Modifier {
  public:
   static std::shared_ptr<Modifier> MakeBlend(float alpha, tgfx::BlendMode blendMode);
   static std::shared_ptr<Modifier> MakeClip(const tgfx::Path& clip);
+  /**
+   * Creates a mask modifier. If the maskID is not 0, the rasterized mask is cached by the
+   * RenderCache and reused across frames until the maskKey changes.
+   */
   static std::shared_ptr<Modifier> MakeMask(std::shared_ptr<Graphic> graphic, bool inverted,
-                                            bool useLuma);
+                                            bool useLuma, ID maskID = 0, uint64_t maskKey = 0);
 
   virtual ~Modifier() = default;
 
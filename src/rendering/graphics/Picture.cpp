@@ -17,8 +17,11 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "Picture.h"
+#include <mutex>
 #include "base/utils/MatrixUtil.h"
 #include "rendering/caches/RenderCache.h"
+#include "rendering/graphics/HitTestMask.h"
+#include "rendering/utils/Tracer.h"
 #include "tgfx/core/Clock.h"
 #include "tgfx/gpu/Surface.h"
 #include "tgfx/gpu/opengl/GLDevice.h"
@@ -65,19 +68,24 @@ static void DrawDirectly(tgfx::Canvas* canvas, const tgfx::Texture* texture,
   canvas->flush();
 }
 
+// textureMatrix 用于将解码分辨率降低后的纹理映射回原始尺寸 (contentWidth x contentHeight)。
 static std::shared_ptr<tgfx::Texture> RescaleTexture(tgfx::Context* context, tgfx::Texture* texture,
+                                                     float contentWidth, float contentHeight,
+                                                     const tgfx::Matrix& textureMatrix,
                                                      float scaleFactor) {
   if (texture == nullptr || scaleFactor == 0) {
     return nullptr;
   }
-  auto width = static_cast<int>(ceilf(texture->width() * scaleFactor));
-  auto height = static_cast<int>(ceilf(texture->height() * scaleFactor));
+  auto width = static_cast<int>(ceilf(contentWidth * scaleFactor));
+  auto height = static_cast<int>(ceilf(contentHeight * scaleFactor));
   auto surface = tgfx::Surface::Make(context, width, height);
   if (surface == nullptr) {
     return nullptr;
   }
   auto canvas = surface->getCanvas();
-  canvas->setMatrix(tgfx::Matrix::MakeScale(scaleFactor));
+  auto matrix = tgfx::Matrix::MakeScale(scaleFactor);
+  matrix.preConcat(textureMatrix);
+  canvas->setMatrix(matrix);
   canvas->drawTexture(texture);
   return surface->getTexture();
 }
@@ -85,8 +93,9 @@ static std::shared_ptr<tgfx::Texture> RescaleTexture(tgfx::Context* context, tgf
 //================================= TextureProxySnapshotPicture ====================================
 class TextureProxyPicture : public Picture {
  public:
-  TextureProxyPicture(ID assetID, TextureProxy* proxy, bool externalMemory)
-      : Picture(assetID), proxy(proxy), externalMemory(externalMemory) {
+  TextureProxyPicture(ID assetID, TextureProxy* proxy, bool externalMemory,
+                      uint64_t contentKey = 0)
+      : Picture(assetID, contentKey), proxy(proxy), externalMemory(externalMemory) {
   }
 
   ~TextureProxyPicture() override {
@@ -103,18 +112,21 @@ class TextureProxyPicture : public Picture {
     if (snapshot) {
       return snapshot->hitTest(cache, x, y);
     }
-    auto texture = proxy->getTexture(cache);
-    if (texture == nullptr) {
-      return false;
-    }
-    auto surface = tgfx::Surface::Make(cache->getContext(), 1, 1);
-    if (surface == nullptr) {
-      return false;
+    // 图片可能被多个播放器共享，在不同线程同时进行碰撞检测。
+    std::lock_guard<std::mutex> autoLock(locker);
+    if (hitTestMask == nullptr) {
+      auto texture = proxy->getTexture(cache);
+      if (texture == nullptr) {
+        return false;
+      }
+      tgfx::Rect bounds = {};
+      measureBounds(&bounds);
+      hitTestMask = HitTestMask::Make(cache->getContext(), bounds, [&](tgfx::Canvas* canvas) {
+        canvas->concat(getTextureMatrix(texture.get()));
+        canvas->drawTexture(texture.get());
+      });
     }
-    auto canvas = surface->getCanvas();
-    canvas->setMatrix(tgfx::Matrix::MakeTrans(-x, -y));
-    canvas->drawTexture(texture.get());
-    return surface->hitTest(0, 0);
+    return hitTestMask != nullptr && hitTestMask->hitTest(x, y);
   }
 
   bool getPath(tgfx::Path*) const override {
@@ -130,16 +142,24 @@ class TextureProxyPicture : public Picture {
     canvas->concat(extraMatrix);
     if (proxy->cacheEnabled()) {
       auto texture = proxy->getTexture(cache);
+      if (texture) {
+        canvas->concat(getTextureMatrix(texture.get()));
+      }
       if (TryDrawDirectly(canvas, texture.get(), nullptr)) {
         canvas->setMatrix(oldMatrix);
         return;
       }
+      canvas->setMatrix(oldMatrix);
+      canvas->concat(extraMatrix);
     }
     auto snapshot = cache->getSnapshot(this);
     if (snapshot) {
       canvas->drawTexture(snapshot->getTexture().get(), snapshot->getMatrix());
     } else {
       auto texture = proxy->getTexture(cache);
+      if (texture) {
+        canvas->concat(getTextureMatrix(texture.get()));
+      }
       DrawDirectly(canvas, texture.get(), nullptr);
     }
     canvas->setMatrix(oldMatrix);
@@ -148,6 +168,8 @@ class TextureProxyPicture : public Picture {
  private:
   TextureProxy* proxy = nullptr;
   bool externalMemory = false;
+  std::mutex locker = {};
+  std::unique_ptr<HitTestMask> hitTestMask = nullptr;
   tgfx::Matrix extraMatrix = tgfx::Matrix::I();
 
   float getScaleFactor(float maxScaleFactor) const override {
@@ -158,13 +180,37 @@ class TextureProxyPicture : public Picture {
     return std::min(maxScaleFactor, 1.0f);
   }
 
+  // 返回应用 extraMatrix 之前的原始内容尺寸。
+  tgfx::Point getContentSize() const {
+    auto width = static_cast<float>(proxy->width());
+    auto height = static_cast<float>(proxy->height());
+    if (extraMatrix.getScaleX() == 0) {
+      // extraMatrix 包含 90 度旋转时，原始内容的宽高是互换的。
+      std::swap(width, height);
+    }
+    return {width, height};
+  }
+
+  // 返回将纹理映射到原始内容尺寸的矩阵，纹理可能是以较低的分辨率解码的。
+  tgfx::Matrix getTextureMatrix(const tgfx::Texture* texture) const {
+    auto size = getContentSize();
+    return tgfx::Matrix::MakeScale(size.x / static_cast<float>(texture->width()),
+                                   size.y / static_cast<float>(texture->height()));
+  }
+
   std::unique_ptr<Snapshot> makeSnapshot(RenderCache* cache, float scaleFactor) const override {
     auto texture = proxy->getTexture(cache);
     if (texture == nullptr) {
       return nullptr;
     }
-    if (scaleFactor != 1.0f || texture->isYUV()) {
-      texture = RescaleTexture(cache->getContext(), texture.get(), scaleFactor);
+    auto contentSize = getContentSize();
+    auto targetWidth = static_cast<int>(ceilf(contentSize.x * scaleFactor));
+    auto targetHeight = static_cast<int>(ceilf(contentSize.y * scaleFactor));
+    // 解码尺寸恰好等于目标尺寸时可以直接使用，无需再额外缩放一次。
+    auto matchesTarget = texture->width() == targetWidth && texture->height() == targetHeight;
+    if (texture->isYUV() || !matchesTarget) {
+      texture = RescaleTexture(cache->getContext(), texture.get(), contentSize.x, contentSize.y,
+                               getTextureMatrix(texture.get()), scaleFactor);
     }
     if (texture == nullptr) {
       return nullptr;
@@ -198,16 +244,20 @@ class RGBAAAPicture : public Picture {
     if (snapshot) {
       return snapshot->hitTest(cache, x, y);
     }
-    auto texture = proxy->getTexture(cache);
-    auto surface = tgfx::Surface::Make(cache->getContext(), 1, 1);
-    if (surface == nullptr) {
-      return false;
+    // 图片可能被多个播放器共享，在不同线程同时进行碰撞检测。
+    std::lock_guard<std::mutex> autoLock(locker);
+    if (hitTestMask == nullptr) {
+      auto texture = proxy->getTexture(cache);
+      if (texture == nullptr) {
+        return false;
+      }
+      tgfx::Rect bounds = {};
+      measureBounds(&bounds);
+      hitTestMask = HitTestMask::Make(cache->getContext(), bounds, [&](tgfx::Canvas* canvas) {
+        canvas->drawTexture(texture.get(), &layout);
+      });
     }
-    auto canvas = surface->getCanvas();
-    auto matrix = tgfx::Matrix::MakeTrans(static_cast<float>(-x), static_cast<float>(-y));
-    canvas->setMatrix(matrix);
-    canvas->drawTexture(texture.get(), &layout);
-    return surface->hitTest(0, 0);
+    return hitTestMask != nullptr && hitTestMask->hitTest(x, y);
   }
 
   bool getPath(tgfx::Path*) const override {
@@ -241,6 +291,8 @@ class RGBAAAPicture : public Picture {
  private:
   TextureProxy* proxy = nullptr;
   tgfx::RGBAAALayout layout = {};
+  std::mutex locker = {};
+  std::unique_ptr<HitTestMask> hitTestMask = nullptr;
 
   float getScaleFactor(float maxScaleFactor) const override {
     // 视频帧缩放值不需要大于 1.0f，清晰度无法继续提高。
@@ -274,8 +326,9 @@ class SnapshotPictureOptions : public tgfx::SurfaceOptions {
 
 class SnapshotPicture : public Picture {
  public:
-  SnapshotPicture(ID assetID, std::shared_ptr<Graphic> graphic)
+  SnapshotPicture(ID assetID, std::shared_ptr<Graphic> graphic, ID snapshotID)
       : Picture(assetID), graphic(std::move(graphic)) {
+    this->snapshotID = snapshotID;
   }
 
   void measureBounds(tgfx::Rect* bounds) const override {
@@ -284,7 +337,7 @@ class SnapshotPicture : public Picture {
 
   bool hitTest(RenderCache* cache, float x, float y) override {
     // 碰撞检测过程不允许生成新的GPU缓存，因为碰撞结束不会触发缓存清理操作，长时间不进入下一次绘制有可能导致显存泄露。
-    auto snapshot = cache->getSnapshot(assetID);
+    auto snapshot = cache->findSnapshot(this);
     if (snapshot) {
       return snapshot->hitTest(cache, x, y);
     }
@@ -386,10 +439,19 @@ class ImageTextureProxy : public TextureProxy {
   }
 
   std::shared_ptr<tgfx::Texture> getTexture(RenderCache* cache) const override {
+    TRACE_SPAN("ImageTextureProxy::getTexture");
     tgfx::Clock clock = {};
+    auto scaleFactor = cache->getImageDecodingScale(assetID);
     auto buffer = cache->getImageBuffer(assetID);
+    auto minWidth = static_cast<float>(image->width()) * scaleFactor;
+    auto minHeight = static_cast<float>(image->height()) * scaleFactor;
+    if (buffer != nullptr && (static_cast<float>(buffer->width()) < minWidth ||
+                              static_cast<float>(buffer->height()) < minHeight)) {
+      // The scale factor has grown since the image was prepared.
+      buffer = nullptr;
+    }
     if (buffer == nullptr) {
-      buffer = image->makeBuffer();
+      buffer = image->makeBuffer(scaleFactor);
     }
     cache->recordImageDecodingTime(clock.measure());
     if (buffer == nullptr) {
@@ -453,10 +515,16 @@ class BackendTextureProxy : public TextureProxy {
 
 static std::atomic_uint64_t IDCount = {1};
 
-Picture::Picture(ID assetID) : assetID(assetID), uniqueKey(IDCount++) {
+Picture::Picture(ID assetID, uint64_t contentKey)
+    : assetID(assetID), snapshotID(assetID), uniqueKey(contentKey > 0 ? contentKey : IDCount++) {
 }
 
 std::shared_ptr<Graphic> Picture::MakeFrom(ID assetID, std::shared_ptr<tgfx::Image> image) {
+  return MakeFrom(assetID, std::move(image), 0);
+}
+
+std::shared_ptr<Graphic> Picture::MakeFrom(ID assetID, std::shared_ptr<tgfx::Image> image,
+                                           uint64_t contentKey) {
   if (image == nullptr) {
     return nullptr;
   }
@@ -466,7 +534,7 @@ std::shared_ptr<Graphic> Picture::MakeFrom(ID assetID, std::shared_ptr<tgfx::Ima
   ApplyOrientation(image->orientation(), &width, &height);
   auto textureProxy =
       new ImageTextureProxy(assetID, static_cast<int>(width), static_cast<int>(height), image);
-  auto picture = std::make_shared<TextureProxyPicture>(assetID, textureProxy, false);
+  auto picture = std::make_shared<TextureProxyPicture>(assetID, textureProxy, false, contentKey);
   picture->extraMatrix = extraMatrix;
   return picture;
 }
@@ -516,7 +584,16 @@ std::shared_ptr<Graphic> Picture::MakeFrom(ID assetID, std::shared_ptr<Graphic>
   if (assetID == 0 || graphic == nullptr || graphic->type() == GraphicType::Picture) {
     return graphic;
   }
-  return std::make_shared<SnapshotPicture>(assetID, graphic);
+  return std::make_shared<SnapshotPicture>(assetID, graphic, assetID);
+}
+
+std::shared_ptr<Graphic> Picture::MakeFrom(ID assetID, std::shared_ptr<Graphic> graphic,
+                                           ID snapshotID) {
+  if (assetID == 0 || snapshotID == 0 || graphic == nullptr ||
+      graphic->type() == GraphicType::Picture) {
+    return graphic;
+  }
+  return std::make_shared<SnapshotPicture>(assetID, graphic, snapshotID);
 }
 
 }  // namespace pag
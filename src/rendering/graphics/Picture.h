@@ -40,6 +40,14 @@ class Picture : public Graphic {
    */
   static std::shared_ptr<Graphic> MakeFrom(ID assetID, std::shared_ptr<tgfx::Image> image);
 
+  /**
+   * Creates a new Picture with specified Image and content key. Pictures created with the same
+   * assetID and contentKey are treated as the same content and share the cached texture during
+   * rendering. Return null if the image is null.
+   */
+  static std::shared_ptr<Graphic> MakeFrom(ID assetID, std::shared_ptr<tgfx::Image> image,
+                                           uint64_t contentKey);
+
   /**
    * Creates a new Picture with specified TextureBuffer. Returns null if the bitmap is empty.
    */
@@ -70,7 +78,20 @@ class Picture : public Graphic {
    */
   static std::shared_ptr<Graphic> MakeFrom(ID assetID, std::shared_ptr<Graphic> graphic);
 
-  explicit Picture(ID assetID);
+  /**
+   * Creates a new Picture with specified graphic, whose texture representation is cached under the
+   * snapshotID instead of the assetID. Pictures of the same asset with different contents can use
+   * different snapshotIDs to keep their cached textures at the same time. The assetID is still
+   * used to compute the max scale factor.
+   */
+  static std::shared_ptr<Graphic> MakeFrom(ID assetID, std::shared_ptr<Graphic> graphic,
+                                           ID snapshotID);
+
+  /**
+   * Creates a new Picture with the specified content key, a new unique key is generated if the
+   * contentKey is 0.
+   */
+  explicit Picture(ID assetID, uint64_t contentKey = 0);
 
   GraphicType type() const final {
     return GraphicType::Picture;
@@ -78,6 +99,7 @@ class Picture : public Graphic {
 
  protected:
   ID assetID = 0;
+  ID snapshotID = 0;
 
   virtual float getScaleFactor(float maxScaleFactor) const = 0;
   virtual std::unique_ptr<Snapshot> makeSnapshot(RenderCache* cache, float scaleFactor) const = 0;
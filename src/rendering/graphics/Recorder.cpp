@@ -19,43 +19,12 @@
 #include "Recorder.h"
 
 namespace pag {
-enum class RecordType { Matrix, Layer };
-
-class Record {
- public:
-  explicit Record(const tgfx::Matrix& matrix) : matrix(matrix) {
-  }
-
-  virtual ~Record() = default;
-
-  virtual RecordType type() const {
-    return RecordType::Matrix;
-  }
-
-  tgfx::Matrix matrix = {};
-};
-
-class LayerRecord : public Record {
- public:
-  LayerRecord(const tgfx::Matrix& matrix, std::shared_ptr<Modifier> modifier,
-              std::vector<std::shared_ptr<Graphic>> contents)
-      : Record(matrix), modifier(std::move(modifier)), oldNodes(std::move(contents)) {
-  }
-
-  RecordType type() const override {
-    return RecordType::Layer;
-  }
-
-  std::shared_ptr<Modifier> modifier = nullptr;
-  std::vector<std::shared_ptr<Graphic>> oldNodes = {};
-};
-
 tgfx::Matrix Recorder::getMatrix() const {
   tgfx::Matrix totalMatrix = matrix;
   for (int i = static_cast<int>(records.size() - 1); i >= 0; i--) {
     auto& record = records[i];
-    if (record->type() == RecordType::Layer) {
-      totalMatrix.postConcat(record->matrix);
+    if (record.modifier != nullptr) {
+      totalMatrix.postConcat(record.matrix);
     }
   }
   return totalMatrix;
@@ -68,8 +37,8 @@ void Recorder::setMatrix(const tgfx::Matrix& m) {
     auto totalMatrix = tgfx::Matrix::I();
     for (auto i = count - 1; i >= 0; i--) {
       auto& record = records[i];
-      if (record->type() == RecordType::Layer) {
-        totalMatrix.postConcat(record->matrix);
+      if (record.modifier != nullptr) {
+        totalMatrix.postConcat(record.matrix);
       }
     }
     if (totalMatrix.invert(&totalMatrix)) {
@@ -89,13 +58,11 @@ void Recorder::saveClip(float x, float y, float width, float height) {
 }
 
 void Recorder::saveClip(const tgfx::Path& path) {
-  auto modifier = Modifier::MakeClip(path);
-  saveLayer(modifier);
+  saveLayer(Modifier::MakeClip(path));
 }
 
 void Recorder::saveLayer(float alpha, tgfx::BlendMode blendMode) {
-  auto modifier = Modifier::MakeBlend(alpha, blendMode);
-  saveLayer(modifier);
+  saveLayer(Modifier::MakeBlend(alpha, blendMode));
 }
 
 void Recorder::saveLayer(std::shared_ptr<Modifier> modifier) {
@@ -103,32 +70,31 @@ void Recorder::saveLayer(std::shared_ptr<Modifier> modifier) {
     save();
     return;
   }
-  auto record = std::make_shared<LayerRecord>(matrix, modifier, layerContents);
-  records.push_back(record);
+  // Moves the current contents into the record instead of copying them, which saves an atomic
+  // increment and decrement for every graphic in the outer layer.
+  records.push_back({matrix, std::move(modifier), std::move(layerContents)});
   matrix = tgfx::Matrix::I();
-  layerContents = {};
+  layerContents.clear();
   layerIndex++;
 }
 
 void Recorder::save() {
-  auto record = std::make_shared<Record>(matrix);
-  records.push_back(record);
+  records.push_back({matrix, nullptr, {}});
 }
 
 void Recorder::restore() {
   if (records.empty()) {
     return;
   }
-  auto record = records.back();
+  auto record = std::move(records.back());
   records.pop_back();
-  matrix = record->matrix;
-  if (record->type() == RecordType::Layer) {
+  matrix = record.matrix;
+  if (record.modifier != nullptr) {
     layerIndex--;
-    auto layerRecord = std::static_pointer_cast<LayerRecord>(record);
-    auto layerGraphic = Graphic::MakeCompose(layerContents);
-    layerGraphic = Graphic::MakeCompose(layerGraphic, layerRecord->modifier);
-    layerContents = layerRecord->oldNodes;
-    drawGraphic(layerGraphic);
+    auto layerGraphic = Graphic::MakeCompose(std::move(layerContents));
+    layerGraphic = Graphic::MakeCompose(std::move(layerGraphic), std::move(record.modifier));
+    layerContents = std::move(record.oldNodes);
+    drawGraphic(std::move(layerGraphic));
   }
 }
 
@@ -155,9 +121,9 @@ void Recorder::drawGraphic(std::shared_ptr<Graphic> graphic) {
     return;
   }
   if (layerIndex == 0) {
-    rootContents.push_back(content);
+    rootContents.push_back(std::move(content));
   } else {
-    layerContents.push_back(content);
+    layerContents.push_back(std::move(content));
   }
 }
 
@@ -21,8 +21,6 @@
 #include "Graphic.h"
 
 namespace pag {
-class Record;
-
 /**
  * Recorder provides an interface for recording drawing commands made with Graphics, and creates a
  * new Graphic capturing the whole drawing commands which may be applied at a later time.
@@ -122,10 +120,20 @@ class Recorder {
   std::shared_ptr<Graphic> makeGraphic();
 
  private:
+  /**
+   * A saved Recorder state. The modifier is nullptr for the states pushed by save(). Records are
+   * stored by value to avoid a heap allocation for every save() and saveLayer() during a frame.
+   */
+  struct Record {
+    tgfx::Matrix matrix = {};
+    std::shared_ptr<Modifier> modifier = nullptr;
+    std::vector<std::shared_ptr<Graphic>> oldNodes = {};
+  };
+
   std::vector<std::shared_ptr<Graphic>> rootContents = {};
   int layerIndex = 0;
   tgfx::Matrix matrix = tgfx::Matrix::I();
   std::vector<std::shared_ptr<Graphic>> layerContents = {};
-  std::vector<std::shared_ptr<Record>> records = {};
+  std::vector<Record> records = {};
 };
 }  // namespace pag
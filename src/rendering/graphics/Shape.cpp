@@ -19,6 +19,7 @@
 #include "Shape.h"
 #include "pag/file.h"
 #include "rendering/caches/RenderCache.h"
+#include "rendering/utils/Tracer.h"
 #include "tgfx/core/Mask.h"
 #include "tgfx/gpu/Canvas.h"
 #include "tgfx/gpu/Shader.h"
@@ -94,6 +95,7 @@ void Shape::draw(tgfx::Canvas* canvas, RenderCache* renderCache) const {
 std::unique_ptr<Snapshot> MakeMeshSnapshot(tgfx::Path path, RenderCache*, float scaleFactor) {
   auto matrix = tgfx::Matrix::MakeScale(scaleFactor);
   path.transform(matrix);
+  TRACE_SPAN("Mesh::MakeFrom");
   auto mesh = tgfx::Mesh::MakeFrom(path);
   if (mesh == nullptr) {
     return nullptr;
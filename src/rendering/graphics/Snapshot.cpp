@@ -19,7 +19,6 @@
 #include "Snapshot.h"
 #include "base/utils/MatrixUtil.h"
 #include "rendering/caches/RenderCache.h"
-#include "tgfx/gpu/Surface.h"
 
 namespace pag {
 size_t Snapshot::memoryUsage() const {
@@ -37,23 +36,31 @@ size_t Snapshot::memoryUsage() const {
 }
 
 bool Snapshot::hitTest(RenderCache* cache, float x, float y) const {
+  if (mesh && !path.isEmpty()) {
+    // 网格缓存保留了原始路径，直接在 CPU 上判断即可。
+    return path.contains(x, y);
+  }
   tgfx::Point local = {x, y};
   if (!MapPointInverted(matrix, &local)) {
     return false;
   }
-  auto surface = tgfx::Surface::Make(cache->getContext(), 1, 1);
-  if (surface == nullptr) {
-    return false;
-  }
-  auto canvas = surface->getCanvas();
-  canvas->setMatrix(tgfx::Matrix::MakeTrans(-local.x, -local.y));
-  if (texture) {
-    canvas->drawTexture(texture.get());
-  } else if (mesh) {
-    tgfx::Paint paint;
-    paint.setColor(tgfx::Color::White());
-    canvas->drawMesh(mesh.get(), paint);
+  if (hitTestMask == nullptr) {
+    tgfx::Rect bounds = tgfx::Rect::MakeEmpty();
+    if (texture) {
+      bounds.setWH(static_cast<float>(texture->width()), static_cast<float>(texture->height()));
+    } else if (mesh) {
+      bounds = mesh->bounds();
+    }
+    hitTestMask = HitTestMask::Make(cache->getContext(), bounds, [this](tgfx::Canvas* canvas) {
+      if (texture) {
+        canvas->drawTexture(texture.get());
+      } else if (mesh) {
+        tgfx::Paint paint;
+        paint.setColor(tgfx::Color::White());
+        canvas->drawMesh(mesh.get(), paint);
+      }
+    });
   }
-  return surface->hitTest(0, 0);
+  return hitTestMask != nullptr && hitTestMask->hitTest(local.x, local.y);
 }
 }  // namespace pag
@@ -19,6 +19,7 @@
 #pragma once
 
 #include "pag/types.h"
+#include "rendering/graphics/HitTestMask.h"
 #include "tgfx/core/Matrix.h"
 #include "tgfx/core/Mesh.h"
 #include "tgfx/core/Path.h"
@@ -70,8 +71,8 @@ class Snapshot {
 
   /**
    * Evaluates the Snapshot to see if it overlaps or intersects with the specified point. The point
-   * is in the coordinate space of the Snapshot. This method always checks against the actual pixels
-   * of the Snapshot.
+   * is in the coordinate space of the Snapshot. This method checks against a downsampled alpha mask
+   * of the Snapshot, which is read back from the GPU at the first call and kept for later calls.
    */
   bool hitTest(RenderCache* cache, float x, float y) const;
 
@@ -83,6 +84,7 @@ class Snapshot {
   tgfx::Path path = {};
   Frame idleFrames = 0;
   std::unique_ptr<tgfx::Mesh> mesh;
+  mutable std::unique_ptr<HitTestMask> hitTestMask;
 
   friend class RenderCache;
 };
@@ -203,34 +203,56 @@ std::shared_ptr<Graphic> PAGStage::getSequenceGraphic(Composition* composition,
   return cache.graphic;
 }
 
-std::map<int64_t, std::vector<PAGLayer*>> PAGStage::findNearlyVisibleLayersIn(
-    int64_t timeDistance) {
-  std::map<int64_t, std::vector<PAGLayer*>> distanceMap = {};
+static bool LessThanStartTime(const std::pair<int64_t, PAGLayer*>& item, int64_t time) {
+  return item.first < time;
+}
+
+static bool GreaterThanStartTime(int64_t time, const std::pair<int64_t, PAGLayer*>& item) {
+  return time < item.first;
+}
+
+const std::vector<PAGLayer*>& PAGStage::findNearlyVisibleLayersIn(int64_t timeDistance) {
+  nearlyVisibleLayers.clear();
   auto root = getRootComposition();
   if (root == nullptr) {
-    return distanceMap;
+    return nearlyVisibleLayers;
   }
   auto rootDuration = root->durationInternal();
   auto globalFrameRate = frameRateInternal();
   auto globalFrame = root->localFrameToGlobal(root->currentFrameInternal());
   auto globalCurrent = FrameToTime(globalFrame, globalFrameRate);
   if (rootVersion != root->contentVersion) {
-    layerStartTimeMap = {};
+    layerStartTimes.clear();
     updateLayerStartTime(root.get());
+    std::stable_sort(layerStartTimes.begin(), layerStartTimes.end(),
+                     [](const std::pair<int64_t, PAGLayer*>& a,
+                        const std::pair<int64_t, PAGLayer*>& b) { return a.first < b.first; });
     rootVersion = root->contentVersion;
   }
-  for (auto& item : layerStartTimeMap) {
-    auto visibleStart = item.second;
-    if (globalCurrent > visibleStart) {
-      // 循环预测
-      visibleStart += rootDuration;
-    }
-    auto distance = visibleStart - globalCurrent;
-    if (distance > 0 && distance <= timeDistance) {
-      distanceMap[distance].push_back(item.first);
+  auto begin = layerStartTimes.begin();
+  auto end = layerStartTimes.end();
+  // 即将开始的图层：startTime 位于 (current, current + distance] 区间内。
+  auto aheadStart = std::upper_bound(begin, end, globalCurrent, GreaterThanStartTime);
+  auto aheadEnd = std::upper_bound(aheadStart, end, globalCurrent + timeDistance,
+                                   GreaterThanStartTime);
+  // 循环预测：已经开始过的图层在下一次循环中的 startTime 为 startTime + rootDuration。
+  auto loopStart = std::upper_bound(begin, end, globalCurrent - rootDuration, GreaterThanStartTime);
+  auto loopEnd = std::upper_bound(loopStart, end, globalCurrent + timeDistance - rootDuration,
+                                  GreaterThanStartTime);
+  loopEnd = std::min(loopEnd, std::lower_bound(begin, end, globalCurrent, LessThanStartTime));
+  loopStart = std::min(loopStart, loopEnd);
+  // 两段区间各自按距离有序，归并后整体按距离从小到大排列。
+  while (aheadStart != aheadEnd || loopStart != loopEnd) {
+    if (loopStart == loopEnd ||
+        (aheadStart != aheadEnd && aheadStart->first <= loopStart->first + rootDuration)) {
+      nearlyVisibleLayers.push_back(aheadStart->second);
+      aheadStart++;
+    } else {
+      nearlyVisibleLayers.push_back(loopStart->second);
+      loopStart++;
     }
   }
-  return distanceMap;
+  return nearlyVisibleLayers;
 }
 
 void PAGStage::updateLayerStartTime(PAGLayer* pagLayer) {
@@ -245,7 +267,7 @@ void PAGStage::updateLayerStartTime(PAGLayer* pagLayer) {
     return;
   }
   auto frame = pagLayer->localFrameToGlobal(pagLayer->startFrame);
-  layerStartTimeMap[pagLayer] = FrameToTime(frame, frameRateInternal());
+  layerStartTimes.emplace_back(FrameToTime(frame, frameRateInternal()), pagLayer);
 }
 
 void PAGStage::updateChildLayerStartTime(PAGComposition* pagComposition) {
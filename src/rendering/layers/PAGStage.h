@@ -19,7 +19,6 @@
 #pragma once
 
 #include <cfloat>
-#include <map>
 #include <unordered_set>
 #include "pag/file.h"
 #include "pag/pag.h"
@@ -89,7 +88,14 @@ class PAGStage : public PAGComposition {
 
   std::shared_ptr<Graphic> getSequenceGraphic(Composition* composition, Frame compositionFrame);
 
-  std::map<int64_t, std::vector<PAGLayer*>> findNearlyVisibleLayersIn(int64_t timeDistance);
+  /**
+   * Returns the image layers and sequence layers that become visible within the specified time
+   * distance from now, sorted by the distance in ascending order. The start times of layers are
+   * indexed in a sorted array which is rebuilt only when the content of the root composition
+   * changes, so each query takes logarithmic time plus the number of layers returned. The
+   * returned vector is reused by the next query.
+   */
+  const std::vector<PAGLayer*>& findNearlyVisibleLayersIn(int64_t timeDistance);
 
   std::unordered_set<ID> getRemovedAssets();
 
@@ -107,7 +113,8 @@ class PAGStage : public PAGComposition {
  private:
   float _cacheScale = 1.0f;
   int64_t rootVersion = -1;
-  std::unordered_map<PAGLayer*, Frame> layerStartTimeMap = {};
+  std::vector<std::pair<int64_t, PAGLayer*>> layerStartTimes = {};
+  std::vector<PAGLayer*> nearlyVisibleLayers = {};
   std::unordered_map<ID, std::vector<PAGLayer*>> layerReferenceMap = {};
   std::unordered_map<ID, float> scaleFactorCache = {};
   std::unordered_map<ID, SequenceCache> sequenceCache = {};
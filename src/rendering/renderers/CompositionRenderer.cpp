@@ -18,6 +18,7 @@
 
 #include "CompositionRenderer.h"
 #include "LayerRenderer.h"
+#include "base/utils/UniqueID.h"
 #include "rendering/caches/LayerCache.h"
 #include "rendering/caches/RenderCache.h"
 #include "rendering/graphics/Picture.h"
@@ -36,6 +37,52 @@ static std::shared_ptr<Graphic> MakeVideoSequenceGraphic(VideoSequence* sequence
                            layout);
 }
 
+// 滤镜和图层样式需要额外的离屏绘制，开销按多个普通图层计算。
+#define EFFECT_RENDERING_COST 4
+// 合成在静态区间内的绘制开销超过该值时，才把整个子树缓存成一张纹理。
+#define MIN_SUBTREE_CACHE_COST 16
+
+/**
+ * 估算每帧绘制一个合成的开销，数值大致对应需要遍历和绘制的节点数量。
+ */
+static int EstimateRenderingCost(VectorComposition* composition) {
+  int cost = 0;
+  for (auto layer : composition->layers) {
+    cost += 1 + static_cast<int>(layer->masks.size());
+    cost += static_cast<int>(layer->effects.size() + layer->layerStyles.size()) *
+            EFFECT_RENDERING_COST;
+    if (layer->motionBlur) {
+      cost += EFFECT_RENDERING_COST;
+    }
+    if (layer->type() == LayerType::Shape) {
+      cost += static_cast<int>(static_cast<ShapeLayer*>(layer)->contents.size());
+    } else if (layer->type() == LayerType::PreCompose) {
+      auto childComposition = static_cast<PreComposeLayer*>(layer)->composition;
+      if (childComposition->type() == CompositionType::Vector) {
+        cost += EstimateRenderingCost(static_cast<VectorComposition*>(childComposition));
+      }
+    }
+  }
+  return cost;
+}
+
+/**
+ * 判断合成在指定帧是否处于一段多帧的静态区间内，并且每帧重绘的开销足够大，值得把整个子树光栅化
+ * 成一张纹理缓存起来。CompositionCache 会让同一个静态区间内的所有帧复用同一个 Graphic，因此缓存的
+ * 纹理在区间内一直有效。每个区间的 Graphic 使用独立的 snapshotID，不同区间的纹理可以同时存在，
+ * 互不替换。
+ */
+static bool ShouldCacheStaticSubtree(VectorComposition* composition, Frame compositionFrame) {
+  bool inStaticRange = false;
+  for (auto& timeRange : composition->staticTimeRanges) {
+    if (timeRange.start <= compositionFrame && compositionFrame <= timeRange.end) {
+      inStaticRange = timeRange.end > timeRange.start;
+      break;
+    }
+  }
+  return inStaticRange && EstimateRenderingCost(composition) >= MIN_SUBTREE_CACHE_COST;
+}
+
 std::shared_ptr<Graphic> RenderVectorComposition(VectorComposition* composition,
                                                  Frame compositionFrame) {
   Recorder recorder = {};
@@ -57,9 +104,13 @@ std::shared_ptr<Graphic> RenderVectorComposition(VectorComposition* composition,
   }
   recorder.restore();
   auto graphic = recorder.makeGraphic();
-  if (layers.size() > 1 && composition->staticContent() && !composition->hasImageContent()) {
+  if (layers.size() > 1 && !composition->hasImageContent()) {
     // 仅当子项列表只存在矢量内容并图层数量大于 1 时才包装一个 Image，避免重复的 Image 包装。
-    graphic = Picture::MakeFrom(composition->uniqueID, graphic);
+    if (composition->staticContent()) {
+      graphic = Picture::MakeFrom(composition->uniqueID, graphic);
+    } else if (ShouldCacheStaticSubtree(composition, compositionFrame)) {
+      graphic = Picture::MakeFrom(composition->uniqueID, graphic, UniqueID::Next());
+    }
   }
   return graphic;
 }
@@ -27,6 +27,7 @@
 #include "rendering/filters/utils/FilterBuffer.h"
 #include "rendering/filters/utils/FilterHelper.h"
 #include "rendering/utils/SurfaceUtil.h"
+#include "rendering/utils/Tracer.h"
 #include "tgfx/gpu/Surface.h"
 
 namespace pag {
@@ -336,6 +337,7 @@ void ApplyFilters(tgfx::Context* context, std::vector<FilterNode> filterNodes,
   auto lastUsesMSAA = false;
   auto size = static_cast<int>(filterNodes.size());
   for (int i = 0; i < size; i++) {
+    TRACE_SPAN("Filter::draw");
     auto& node = filterNodes[i];
     auto source = lastSource == nullptr ? filterSource : lastSource.get();
     if (i == size - 1) {
@@ -57,12 +57,26 @@ static std::shared_ptr<Graphic> RenderColorGlyphs(TextLayer* layer, Frame layerF
 }
 
 static std::shared_ptr<Modifier> MakeMaskModifier(std::shared_ptr<Graphic> content,
-                                                  Enum trackMatteType) {
+                                                  Enum trackMatteType, ID maskID = 0,
+                                                  uint64_t maskKey = 0) {
   auto inverted = (trackMatteType == TrackMatteType::AlphaInverted ||
                    trackMatteType == TrackMatteType::LumaInverted);
   auto useLuma =
       (trackMatteType == TrackMatteType::Luma || trackMatteType == TrackMatteType::LumaInverted);
-  return Modifier::MakeMask(std::move(content), inverted, useLuma);
+  return Modifier::MakeMask(std::move(content), inverted, useLuma, maskID, maskKey);
+}
+
+static uint64_t MakeMaskKey(const TimeRange& timeRange, const Transform& extraTransform) {
+  tgfx::BytesKey bytesKey = {};
+  bytesKey.write(static_cast<uint32_t>(timeRange.start));
+  bytesKey.write(static_cast<uint32_t>(timeRange.end));
+  float values[9] = {};
+  extraTransform.matrix.get9(values);
+  for (auto value : values) {
+    bytesKey.write(value);
+  }
+  bytesKey.write(extraTransform.alpha);
+  return tgfx::BytesHasher()(bytesKey);
 }
 
 std::unique_ptr<TrackMatte> TrackMatteRenderer::Make(PAGLayer* trackMatteOwner) {
@@ -81,8 +95,20 @@ std::unique_ptr<TrackMatte> TrackMatteRenderer::Make(PAGLayer* trackMatteOwner)
   LayerRenderer::DrawLayer(&recorder, trackMatteLayer->layer, layerFrame, filterModifier, nullptr,
                            trackMatteLayer, &extraTransform);
   auto content = recorder.makeGraphic();
+  // The matte keeps unchanged within its static time range, so the rendered matte can be cached
+  // and reused across frames while only the owner layer animates.
+  ID maskID = 0;
+  uint64_t maskKey = 0;
+  if (!trackMatteLayer->contentModified()) {
+    auto layerCache = LayerCache::Get(trackMatteOwner->layer);
+    auto timeRange = layerCache->findTrackMatteStaticTimeRange(trackMatteOwner->contentFrame);
+    if (timeRange != nullptr) {
+      maskID = layerCache->getTrackMatteID();
+      maskKey = MakeMaskKey(*timeRange, extraTransform);
+    }
+  }
   auto trackMatte = std::make_unique<TrackMatte>();
-  trackMatte->modifier = MakeMaskModifier(content, trackMatteType);
+  trackMatte->modifier = MakeMaskModifier(content, trackMatteType, maskID, maskKey);
   if (trackMatte->modifier == nullptr) {
     return nullptr;
   }
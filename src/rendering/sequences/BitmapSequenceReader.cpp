@@ -17,6 +17,7 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "BitmapSequenceReader.h"
+#include "rendering/utils/Tracer.h"
 #include "tgfx/core/Image.h"
 
 namespace pag {
@@ -35,6 +36,7 @@ BitmapSequenceReader::~BitmapSequenceReader() {
 }
 
 bool BitmapSequenceReader::decodeFrame(Frame targetFrame) {
+  TRACE_SPAN("BitmapSequenceReader::decodeFrame");
   // a locker is required here because decodeFrame() could be called from multiple threads.
   std::lock_guard<std::mutex> autoLock(locker);
   if (lastDecodeFrame == targetFrame) {
@@ -79,6 +81,7 @@ std::shared_ptr<tgfx::Texture> BitmapSequenceReader::makeTexture(tgfx::Context*
   if (lastDecodeFrame == -1 || pixelBuffer == nullptr) {
     return nullptr;
   }
+  TRACE_SPAN("BitmapSequenceReader::makeTexture");
   return pixelBuffer->makeTexture(context);
 }
 
@@ -18,6 +18,7 @@
 
 #include "SequenceReader.h"
 #include "rendering/caches/RenderCache.h"
+#include "rendering/utils/Tracer.h"
 
 namespace pag {
 class SequenceTask : public Executor {
@@ -75,6 +76,7 @@ std::shared_ptr<tgfx::Texture> SequenceReader::readTexture(Frame targetFrame, Re
   if (lastFrame == targetFrame) {
     return lastTexture;
   }
+  TRACE_SPAN("SequenceReader::readTexture");
   tgfx::Clock clock = {};
   // Setting the lastTask to nullptr triggers cancel().
   lastTask = nullptr;
@@ -18,6 +18,8 @@
 
 #include "VideoReader.h"
 #include "base/utils/TimeUtil.h"
+#include "rendering/utils/Tracer.h"
+#include "rendering/video/VideoDecoderPool.h"
 #include "tgfx/core/Clock.h"
 
 namespace pag {
@@ -26,6 +28,7 @@ namespace pag {
 #define DECODER_TYPE_FAIL 3
 #define MAX_TRY_DECODE_COUNT 100
 #define FORCE_SOFTWARE_SIZE 160000  // 400x400
+#define MAX_FRAME_CACHE_MEMORY 20971520  // 20M
 
 class GPUDecoderTask : public Executor {
  public:
@@ -47,7 +50,7 @@ class GPUDecoderTask : public Executor {
   }
 
   void execute() override {
-    videoDecoder = VideoDecoder::Make(videoFormat, true);
+    videoDecoder = VideoDecoderPool::Make(videoFormat, true);
   }
 };
 
@@ -58,7 +61,7 @@ static Frame TotalFrames(VideoDemuxer* demuxer) {
 
 VideoReader::VideoReader(std::unique_ptr<VideoDemuxer> videoDemuxer)
     : SequenceReader(TotalFrames(videoDemuxer.get()), videoDemuxer->staticContent()),
-      demuxer(videoDemuxer.release()) {
+      demuxer(videoDemuxer.release()), frameCache(MAX_FRAME_CACHE_MEMORY) {
   auto videoFormat = demuxer->getFormat();
   frameRate = videoFormat.frameRate;
   decoderTypeIndex = DECODER_TYPE_HARDWARE;
@@ -73,11 +76,12 @@ VideoReader::VideoReader(std::unique_ptr<VideoDemuxer> videoDemuxer)
 
 VideoReader::~VideoReader() {
   lastTask = nullptr;
-  destroyVideoDecoder();
+  destroyVideoDecoder(true);
   delete demuxer;
 }
 
 bool VideoReader::decodeFrame(Frame targetFrame) {
+  TRACE_SPAN("VideoReader::decodeFrame");
   // Need a locker here in case there are other threads are decoding at the same time.
   std::lock_guard<std::mutex> autoLock(locker);
   auto targetTime = FrameToTime(targetFrame, frameRate);
@@ -85,6 +89,20 @@ bool VideoReader::decodeFrame(Frame targetFrame) {
   if (sampleTime == currentRenderedTime) {
     return true;
   }
+  auto cachedBuffer = frameCache.find(sampleTime);
+  if (cachedBuffer) {
+    // Serve the frame from the cache and leave the decoder where it is, so the next forward frame
+    // can still be decoded without seeking.
+    lastBuffer = cachedBuffer;
+    currentRenderedTime = sampleTime;
+    return true;
+  }
+  // Only the frames reached by seeking are cached, steady forward playback never requests them
+  // again, and copying every frame would cost a full frame of memcpy each time. The frames skipped
+  // over after seeking to the key frame are cached only when seeking backward, which happens
+  // during reverse playback and scrubbing.
+  auto seeking = demuxer->needSeeking(currentDecodedTime, sampleTime);
+  cacheSkippedFrames = seeking && sampleTime < currentRenderedTime;
   lastBuffer = nullptr;
   currentRenderedTime = INT64_MIN;
   if (!checkVideoDecoder()) {
@@ -97,7 +115,7 @@ bool VideoReader::decodeFrame(Frame targetFrame) {
     success = onDecodeFrame(sampleTime);
     if (!success) {
       // fallback to software decoder.
-      destroyVideoDecoder();
+      destroyVideoDecoder(false);
       decoderTypeIndex++;
       if (checkVideoDecoder()) {
         success = onDecodeFrame(sampleTime);
@@ -112,6 +130,9 @@ bool VideoReader::decodeFrame(Frame targetFrame) {
     lastBuffer = videoDecoder->onRenderFrame();
     if (lastBuffer) {
       currentRenderedTime = currentDecodedTime;
+      if (seeking) {
+        frameCache.add(currentRenderedTime, lastBuffer);
+      }
     }
   }
   return lastBuffer != nullptr;
@@ -121,7 +142,15 @@ std::shared_ptr<tgfx::Texture> VideoReader::makeTexture(tgfx::Context* context)
   if (lastBuffer == nullptr) {
     return nullptr;
   }
-  return lastBuffer->makeTexture(context);
+  TRACE_SPAN("VideoReader::makeTexture");
+  // Upload the new frame into the texture of the previous frame in place if nobody else is holding
+  // it, so that no texture allocation happens during steady-state playback.
+  if (videoTexture != nullptr && videoTexture.use_count() == 1 &&
+      lastBuffer->updateTexture(context, videoTexture.get())) {
+    return videoTexture;
+  }
+  videoTexture = lastBuffer->makeTexture(context);
+  return videoTexture;
 }
 
 void VideoReader::recordPerformance(Performance* performance, int64_t decodingTime) {
@@ -182,6 +211,14 @@ bool VideoReader::onDecodeFrame(int64_t sampleTime) {
     } else if (result == DecodingResult::Success) {
       tryDecodeCount = 0;
       currentDecodedTime = videoDecoder->presentationTime();
+      if (cacheSkippedFrames && currentDecodedTime < sampleTime &&
+          !videoDecoder->isHardwareBacked()) {
+        // Keep the frames skipped over after seeking backward to the key frame, they are most
+        // likely to be requested next by reverse playback or scrubbing. Reading frames back from
+        // software decoders is cheap, while hardware decoders may render them to the output
+        // surface.
+        frameCache.add(currentDecodedTime, videoDecoder->onRenderFrame());
+      }
     } else if (result == DecodingResult::EndOfStream) {
       outputEndOfStream = true;
       return true;
@@ -216,11 +253,15 @@ bool VideoReader::checkVideoDecoder() {
   return false;
 }
 
-void VideoReader::destroyVideoDecoder() {
+void VideoReader::destroyVideoDecoder(bool reusable) {
   if (videoDecoder == nullptr) {
     return;
   }
-  delete videoDecoder;
+  if (reusable) {
+    VideoDecoderPool::Recycle(demuxer->getFormat(), std::unique_ptr<VideoDecoder>(videoDecoder));
+  } else {
+    delete videoDecoder;
+  }
   videoDecoder = nullptr;
   lastBuffer = nullptr;
   currentRenderedTime = INT64_MIN;
@@ -236,7 +277,7 @@ void VideoReader::resetParams() {
 }
 
 bool VideoReader::switchToGPUDecoderOfTask() {
-  destroyVideoDecoder();
+  destroyVideoDecoder(true);
   auto executor = gpuDecoderTask->wait();
   videoDecoder = static_cast<GPUDecoderTask*>(executor)->getDecoder().release();
   gpuDecoderTask = nullptr;
@@ -252,7 +293,7 @@ VideoDecoder* VideoReader::makeVideoDecoder() {
   if (decoderTypeIndex <= DECODER_TYPE_HARDWARE) {
     tgfx::Clock clock = {};
     // try hardware decoder.
-    decoder = VideoDecoder::Make(demuxer->getFormat(), true).release();
+    decoder = VideoDecoderPool::Make(demuxer->getFormat(), true).release();
     hardDecodingInitialTime = clock.measure();
     if (decoder) {
       decoderTypeIndex = DECODER_TYPE_HARDWARE;
@@ -262,7 +303,7 @@ VideoDecoder* VideoReader::makeVideoDecoder() {
   if (decoderTypeIndex <= DECODER_TYPE_SOFTWARE) {
     tgfx::Clock clock = {};
     // try software decoder.
-    decoder = VideoDecoder::Make(demuxer->getFormat(), false).release();
+    decoder = VideoDecoderPool::Make(demuxer->getFormat(), false).release();
     softDecodingInitialTime = clock.measure();
     if (decoder) {
       decoderTypeIndex = DECODER_TYPE_SOFTWARE;
@@ -21,6 +21,7 @@
 #include "SequenceReader.h"
 #include "rendering/video/VideoDecoder.h"
 #include "rendering/video/VideoDemuxer.h"
+#include "rendering/video/VideoFrameCache.h"
 
 namespace pag {
 class VideoReader : public SequenceReader {
@@ -29,6 +30,14 @@ class VideoReader : public SequenceReader {
 
   ~VideoReader() override;
 
+  /**
+   * Returns the cache of recently decoded frames, which is used to serve backward and repeated
+   * seeks without re-decoding.
+   */
+  const VideoFrameCache* getFrameCache() const {
+    return &frameCache;
+  }
+
  protected:
   bool decodeFrame(Frame targetFrame) override;
 
@@ -45,14 +54,21 @@ class VideoReader : public SequenceReader {
   VideoDecoder* videoDecoder = nullptr;
   VideoSample videoSample = {};
   std::shared_ptr<VideoBuffer> lastBuffer = nullptr;
+  std::shared_ptr<tgfx::Texture> videoTexture = nullptr;
+  VideoFrameCache frameCache;
   bool outputEndOfStream = false;
   bool inputEndOfStream = false;
+  bool cacheSkippedFrames = false;
   int64_t currentDecodedTime = INT64_MIN;
   int64_t currentRenderedTime = INT64_MIN;
   int64_t hardDecodingInitialTime = 0;
   int64_t softDecodingInitialTime = 0;
 
-  void destroyVideoDecoder();
+  /**
+   * Destroys the current video decoder. The decoder is returned to the VideoDecoderPool if it is
+   * reusable, otherwise, it is deleted immediately.
+   */
+  void destroyVideoDecoder(bool reusable);
 
   bool checkVideoDecoder();
 
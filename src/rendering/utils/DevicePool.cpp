@@ -0,0 +1,70 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2021 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "DevicePool.h"
+#include "tgfx/gpu/opengl/GLDevice.h"
+
+namespace pag {
+DevicePool* DevicePool::Get() {
+  static auto& pool = *new DevicePool();
+  return &pool;
+}
+
+std::shared_ptr<tgfx::Device> DevicePool::Acquire() {
+  return Get()->acquire();
+}
+
+void DevicePool::SetMaxDeviceCount(int count) {
+  Get()->setMaxDeviceCount(static_cast<size_t>(std::max(count, 1)));
+}
+
+std::shared_ptr<tgfx::Device> DevicePool::acquire() {
+  std::lock_guard<std::mutex> autoLock(locker);
+  std::shared_ptr<tgfx::Device> sharedDevice = nullptr;
+  for (auto& device : devices) {
+    // Each reference held outside the pool indicates a surface that is attached to the device.
+    if (sharedDevice == nullptr || device.use_count() < sharedDevice.use_count()) {
+      sharedDevice = device;
+    }
+  }
+  // The local sharedDevice variable holds one extra reference.
+  if (sharedDevice != nullptr && sharedDevice.use_count() <= 2) {
+    return sharedDevice;
+  }
+  if (devices.size() < maxDeviceCount) {
+    std::shared_ptr<tgfx::Device> device = tgfx::GLDevice::Make();
+    if (device != nullptr) {
+      devices.push_back(device);
+      return device;
+    }
+  }
+  return sharedDevice;
+}
+
+void DevicePool::setMaxDeviceCount(size_t count) {
+  std::lock_guard<std::mutex> autoLock(locker);
+  maxDeviceCount = count;
+  for (auto iter = devices.begin(); iter != devices.end() && devices.size() > maxDeviceCount;) {
+    if (iter->use_count() == 1) {
+      iter = devices.erase(iter);
+    } else {
+      iter++;
+    }
+  }
+}
+}  // namespace pag
@@ -0,0 +1,56 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2021 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "tgfx/gpu/Device.h"
+
+namespace pag {
+/**
+ * DevicePool multiplexes off-screen PAGSurfaces onto a small number of shared GPU devices, so
+ * that the program caches, gradient caches and resource caches of one device can be reused by
+ * all the surfaces attached to it instead of being rebuilt for every new surface.
+ */
+class DevicePool {
+ public:
+  /**
+   * Returns a device from the pool. An idle device is preferred, then a newly created one if the
+   * pool is not full, otherwise the device shared by the fewest surfaces is returned. Returns
+   * nullptr if no device can be created.
+   */
+  static std::shared_ptr<tgfx::Device> Acquire();
+
+  /**
+   * Sets the maximum number of devices in the pool. Idle devices beyond the limit are released
+   * immediately.
+   */
+  static void SetMaxDeviceCount(int count);
+
+ private:
+  std::mutex locker = {};
+  std::vector<std::shared_ptr<tgfx::Device>> devices = {};
+  size_t maxDeviceCount = 2;
+
+  static DevicePool* Get();
+  std::shared_ptr<tgfx::Device> acquire();
+  void setMaxDeviceCount(size_t count);
+};
+}  // namespace pag
@@ -0,0 +1,185 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2021 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "Tracer.h"
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "pag/file.h"
+#include "pag/pag.h"
+#include "tgfx/core/Clock.h"
+
+namespace pag {
+#define MAX_TRACE_EVENT_COUNT 4096
+#define MAX_LAYER_NAME_LENGTH 32
+
+struct TraceEvent {
+  const char* name = nullptr;
+  int64_t startTime = 0;
+  int64_t duration = 0;
+  ID layerID = 0;
+  char layerName[MAX_LAYER_NAME_LENGTH] = {};
+};
+
+struct ThreadBuffer {
+  explicit ThreadBuffer(uint32_t threadID) : threadID(threadID) {
+  }
+
+  uint32_t threadID = 0;
+  std::atomic<uint64_t> count = {0};
+  TraceEvent events[MAX_TRACE_EVENT_COUNT] = {};
+};
+
+std::atomic_bool Tracer::enabled = {false};
+static std::mutex bufferLocker = {};
+static std::vector<std::shared_ptr<ThreadBuffer>> threadBuffers = {};
+
+static ThreadBuffer* GetThreadBuffer() {
+  // The buffers are kept alive by the registry after their threads exit, so that the spans of
+  // finished threads can still be exported.
+  thread_local std::shared_ptr<ThreadBuffer> threadBuffer = nullptr;
+  if (threadBuffer == nullptr) {
+    std::lock_guard<std::mutex> autoLock(bufferLocker);
+    threadBuffer = std::make_shared<ThreadBuffer>(static_cast<uint32_t>(threadBuffers.size() + 1));
+    threadBuffers.push_back(threadBuffer);
+  }
+  return threadBuffer.get();
+}
+
+void Tracer::SetEnabled(bool value) {
+  enabled = value;
+}
+
+void Tracer::Record(const char* name, int64_t startTime, int64_t endTime, const Layer* layer) {
+  auto buffer = GetThreadBuffer();
+  auto index = buffer->count.load(std::memory_order_relaxed);
+  auto& event = buffer->events[index % MAX_TRACE_EVENT_COUNT];
+  event.name = name;
+  event.startTime = startTime;
+  event.duration = endTime - startTime;
+  event.layerID = layer ? layer->id : 0;
+  event.layerName[0] = '\0';
+  if (layer != nullptr) {
+    auto& layerName = layer->name;
+    auto length = std::min(layerName.size(), static_cast<size_t>(MAX_LAYER_NAME_LENGTH - 1));
+    // Never cut a UTF-8 sequence in the middle, otherwise the exported JSON becomes invalid.
+    while (length > 0 && length < layerName.size() &&
+           (static_cast<uint8_t>(layerName[length]) & 0xC0) == 0x80) {
+      length--;
+    }
+    memcpy(event.layerName, layerName.data(), length);
+    event.layerName[length] = '\0';
+  }
+  buffer->count.store(index + 1, std::memory_order_release);
+}
+
+static void AppendEscaped(std::string* json, const char* text) {
+  for (auto c = text; *c != '\0'; c++) {
+    switch (*c) {
+      case '"':
+        json->append("\\\"");
+        break;
+      case '\\':
+        json->append("\\\\");
+        break;
+      default:
+        if (static_cast<unsigned char>(*c) < 0x20) {
+          json->push_back(' ');
+        } else {
+          json->push_back(*c);
+        }
+        break;
+    }
+  }
+}
+
+static void AppendEvent(std::string* json, const TraceEvent& event, uint32_t threadID) {
+  json->append("{\"name\":\"");
+  AppendEscaped(json, event.name);
+  json->append("\",\"cat\":\"pag\",\"ph\":\"X\",\"pid\":1,\"tid\":");
+  json->append(std::to_string(threadID));
+  json->append(",\"ts\":");
+  json->append(std::to_string(event.startTime));
+  json->append(",\"dur\":");
+  json->append(std::to_string(event.duration));
+  if (event.layerID > 0) {
+    json->append(",\"args\":{\"layerID\":");
+    json->append(std::to_string(event.layerID));
+    json->append(",\"layerName\":\"");
+    AppendEscaped(json, event.layerName);
+    json->append("\"}");
+  }
+  json->append("}");
+}
+
+std::string Tracer::ExportJSON() {
+  std::string json = "{\"traceEvents\":[";
+  bool first = true;
+  std::lock_guard<std::mutex> autoLock(bufferLocker);
+  for (auto& buffer : threadBuffers) {
+    auto count = buffer->count.load(std::memory_order_acquire);
+    auto start = count > MAX_TRACE_EVENT_COUNT ? count - MAX_TRACE_EVENT_COUNT : 0;
+    for (auto i = start; i < count; i++) {
+      if (!first) {
+        json.append(",");
+      }
+      first = false;
+      AppendEvent(&json, buffer->events[i % MAX_TRACE_EVENT_COUNT], buffer->threadID);
+    }
+  }
+  json.append("]}");
+  return json;
+}
+
+void Tracer::Clear() {
+  std::lock_guard<std::mutex> autoLock(bufferLocker);
+  for (auto& buffer : threadBuffers) {
+    buffer->count = 0;
+  }
+}
+
+void TraceSpan::start(const char* spanName, const Layer* spanLayer) {
+  name = spanName;
+  layer = spanLayer;
+  startTime = tgfx::Clock::Now();
+}
+
+void TraceSpan::finish() {
+  Tracer::Record(name, startTime, tgfx::Clock::Now(), layer);
+}
+
+//===================================== PAGTrace =====================================
+
+void PAGTrace::SetEnabled(bool enabled) {
+  Tracer::SetEnabled(enabled);
+}
+
+bool PAGTrace::IsEnabled() {
+  return Tracer::IsEnabled();
+}
+
+std::string PAGTrace::ExportJSON() {
+  return Tracer::ExportJSON();
+}
+
+void PAGTrace::Clear() {
+  Tracer::Clear();
+}
+}  // namespace pag
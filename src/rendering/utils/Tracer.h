@@ -0,0 +1,108 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2021 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <atomic>
+#include <string>
+#include "pag/types.h"
+
+namespace pag {
+class Layer;
+
+/**
+ * Tracer records scoped trace spans into per-thread ring buffers and exports them in the Chrome
+ * trace-event format, which can be viewed in chrome://tracing or Perfetto. Recording is lock-free,
+ * each thread only writes into its own buffer. When tracing is disabled, a span costs one relaxed
+ * atomic load.
+ */
+class Tracer {
+ public:
+  /**
+   * Returns true if tracing is enabled.
+   */
+  static bool IsEnabled() {
+    return enabled.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * Enables or disables tracing. Recorded spans are kept until Clear() is called.
+   */
+  static void SetEnabled(bool value);
+
+  /**
+   * Returns all the recorded spans as a Chrome trace-event JSON string. Only the most recent spans
+   * of each thread are kept if the ring buffer overflows. The result is exact only if no span is
+   * recorded during the export, for example, when tracing is disabled.
+   */
+  static std::string ExportJSON();
+
+  /**
+   * Removes all the recorded spans.
+   */
+  static void Clear();
+
+ private:
+  static std::atomic_bool enabled;
+
+  static void Record(const char* name, int64_t startTime, int64_t endTime, const Layer* layer);
+
+  friend class TraceSpan;
+};
+
+/**
+ * TraceSpan records the time between its construction and destruction as a span of the current
+ * thread.
+ */
+class TraceSpan {
+ public:
+  explicit TraceSpan(const char* name, const Layer* layer = nullptr) {
+    if (Tracer::IsEnabled()) {
+      start(name, layer);
+    }
+  }
+
+  ~TraceSpan() {
+    if (startTime >= 0) {
+      finish();
+    }
+  }
+
+ private:
+  const char* name = nullptr;
+  const Layer* layer = nullptr;
+  int64_t startTime = -1;
+
+  void start(const char* spanName, const Layer* spanLayer);
+  void finish();
+};
+
+#define TRACE_CONCAT_INTERNAL(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INTERNAL(a, b)
+
+/**
+ * Records a span named by the specified string literal until the end of current scope.
+ */
+#define TRACE_SPAN(name) pag::TraceSpan TRACE_CONCAT(traceSpan, __LINE__)(name)
+
+/**
+ * Records a span with the id and name of the specified layer until the end of current scope.
+ */
+#define TRACE_LAYER_SPAN(name, layer) \
+  pag::TraceSpan TRACE_CONCAT(traceSpan, __LINE__)(name, layer)
+}  // namespace pag
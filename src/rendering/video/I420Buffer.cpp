@@ -17,10 +17,29 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "I420Buffer.h"
+#include <cstring>
+#include "tgfx/core/Buffer.h"
 
 namespace pag {
 #define I420_PLANE_COUNT 3
 
+class CopiedI420Buffer : public I420Buffer {
+ public:
+  CopiedI420Buffer(int width, int height, uint8_t* data[3], const int lineSize[3],
+                   tgfx::YUVColorSpace colorSpace, tgfx::YUVColorRange colorRange,
+                   std::unique_ptr<tgfx::Buffer> pixels)
+      : I420Buffer(width, height, data, lineSize, colorSpace, colorRange),
+        pixels(std::move(pixels)) {
+  }
+
+  size_t memoryUsage() const override {
+    return pixels->size();
+  }
+
+ private:
+  std::unique_ptr<tgfx::Buffer> pixels = nullptr;
+};
+
 I420Buffer::I420Buffer(int width, int height, uint8_t** data, const int* lineSize,
                        tgfx::YUVColorSpace colorSpace, tgfx::YUVColorRange colorRange)
     : VideoBuffer(width, height), colorSpace(colorSpace), colorRange(colorRange) {
@@ -41,4 +60,40 @@ std::shared_ptr<tgfx::Texture> I420Buffer::makeTexture(tgfx::Context* context) c
   return tgfx::YUVTexture::MakeI420(context, colorSpace, colorRange, width(), height(),
                                     const_cast<uint8_t**>(pixelsPlane), rowBytesPlane);
 }
+
+bool I420Buffer::updateTexture(tgfx::Context* context, tgfx::Texture* texture) const {
+  if (context == nullptr || texture == nullptr || !texture->isYUV() ||
+      texture->getContext() != context || texture->width() != width() ||
+      texture->height() != height()) {
+    return false;
+  }
+  auto yuvTexture = static_cast<tgfx::YUVTexture*>(texture);
+  if (yuvTexture->colorSpace() != colorSpace || yuvTexture->colorRange() != colorRange) {
+    return false;
+  }
+  return yuvTexture->updateI420(const_cast<uint8_t**>(pixelsPlane), rowBytesPlane);
+}
+
+std::shared_ptr<VideoBuffer> I420Buffer::makeCopy() const {
+  size_t planeSizes[I420_PLANE_COUNT] = {};
+  size_t totalSize = 0;
+  for (int i = 0; i < I420_PLANE_COUNT; i++) {
+    auto rows = i == 0 ? height() : (height() + 1) / 2;
+    planeSizes[i] = static_cast<size_t>(rowBytesPlane[i]) * rows;
+    totalSize += planeSizes[i];
+  }
+  auto pixels = std::make_unique<tgfx::Buffer>(totalSize);
+  if (pixels->empty()) {
+    return nullptr;
+  }
+  uint8_t* data[I420_PLANE_COUNT] = {};
+  size_t offset = 0;
+  for (int i = 0; i < I420_PLANE_COUNT; i++) {
+    data[i] = pixels->bytes() + offset;
+    memcpy(data[i], pixelsPlane[i], planeSizes[i]);
+    offset += planeSizes[i];
+  }
+  return std::make_shared<CopiedI420Buffer>(width(), height(), data, rowBytesPlane, colorSpace,
+                                            colorRange, std::move(pixels));
+}
 }  // namespace pag
@@ -27,6 +27,10 @@ class I420Buffer : public VideoBuffer {
 
   std::shared_ptr<tgfx::Texture> makeTexture(tgfx::Context* context) const override;
 
+  std::shared_ptr<VideoBuffer> makeCopy() const override;
+
+  bool updateTexture(tgfx::Context* context, tgfx::Texture* texture) const override;
+
  protected:
   I420Buffer(int width, int height, uint8_t* data[3], const int lineSize[3],
              tgfx::YUVColorSpace colorSpace, tgfx::YUVColorRange colorRange);
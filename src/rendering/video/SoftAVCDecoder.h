@@ -43,6 +43,12 @@ namespace pag {
  */
 class SoftAVCDecoder : public SoftwareDecoder {
  public:
+  /**
+   * Creates a decoder which decodes each frame with the specified number of threads. libavc uses
+   * up to 3 threads, one for parsing and the others for reconstructing macroblock rows.
+   */
+  explicit SoftAVCDecoder(int threadCount);
+
   ~SoftAVCDecoder() override;
 
   bool onConfigure(const std::vector<HeaderData>& headers, std::string mime, int width,
@@ -65,6 +71,7 @@ class SoftAVCDecoder : public SoftwareDecoder {
   ivd_video_decode_ip_t decodeInput = {};
   ivd_video_decode_op_t decodeOutput = {};
   bool flushed = true;
+  int threadCount = 1;
 
   bool initDecoder();
   bool openDecoder();
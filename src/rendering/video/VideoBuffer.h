@@ -32,6 +32,32 @@ class VideoBuffer : public tgfx::TextureBuffer {
    */
   virtual size_t planeCount() const = 0;
 
+  /**
+   * Returns a copy of this video buffer which owns its pixels, so it remains valid after the
+   * decoder outputs the next frame. Returns nullptr if the buffer can not be copied, for example
+   * if the pixels are stored in a hardware surface owned by the decoder.
+   */
+  virtual std::shared_ptr<VideoBuffer> makeCopy() const {
+    return nullptr;
+  }
+
+  /**
+   * Returns the number of bytes of pixels owned by this video buffer, including the row padding.
+   * Returns 0 if the pixels are owned by the decoder.
+   */
+  virtual size_t memoryUsage() const {
+    return 0;
+  }
+
+  /**
+   * Uploads the pixels of this video buffer into the specified texture in place, which is usually
+   * the texture made from the previous frame. Returns false if the texture is not compatible with
+   * this video buffer, in which case a new texture should be made by calling makeTexture().
+   */
+  virtual bool updateTexture(tgfx::Context*, tgfx::Texture*) const {
+    return false;
+  }
+
  protected:
   VideoBuffer(int width, int height) : tgfx::TextureBuffer(width, height) {
   }
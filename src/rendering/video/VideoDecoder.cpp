@@ -17,10 +17,12 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "VideoDecoder.h"
+#include <algorithm>
 #include <atomic>
 #include <mutex>
 #include "SoftAVCDecoder.h"
 #include "SoftwareDecoderWrapper.h"
+#include "base/utils/Task.h"
 #include "pag/pag.h"
 #include "platform/Platform.h"
 
@@ -28,11 +30,16 @@ namespace pag {
 static std::atomic<SoftwareDecoderFactory*> softwareDecoderFactory = {nullptr};
 static std::atomic_int maxHardwareDecoderCount = {65535};
 static std::atomic_int globalGPUDecoderCount = {0};
+static std::atomic_int softwareDecoderThreadCount = {0};
 
 void PAGVideoDecoder::SetMaxHardwareDecoderCount(int count) {
   maxHardwareDecoderCount = count;
 }
 
+void PAGVideoDecoder::SetSoftwareDecoderThreadCount(int count) {
+  softwareDecoderThreadCount = count;
+}
+
 void PAGVideoDecoder::RegisterSoftwareDecoderFactory(SoftwareDecoderFactory* decoderFactory) {
   softwareDecoderFactory = decoderFactory;
 }
@@ -45,6 +52,20 @@ int VideoDecoder::GetMaxHardwareDecoderCount() {
   return maxHardwareDecoderCount;
 }
 
+int VideoDecoder::GetSoftwareDecoderThreadCount() {
+  int threadCount = softwareDecoderThreadCount;
+  if (threadCount > 0) {
+    return threadCount;
+  }
+#ifdef PAG_BUILD_FOR_WEB
+  return 1;
+#else
+  // Leave half of the CPU cores for rendering and the other decoders running at the same time.
+  static const int CPUCores = GetCPUCores();
+  return std::max(CPUCores / 2, 1);
+#endif
+}
+
 bool VideoDecoder::HasSoftwareDecoder() {
 #ifdef PAG_USE_LIBAVC
   return true;
@@ -82,7 +103,8 @@ std::unique_ptr<VideoDecoder> VideoDecoder::CreateSoftwareDecoder(const VideoFor
 
 #ifdef PAG_USE_LIBAVC
   if (videoDecoder == nullptr) {
-    videoDecoder = SoftwareDecoderWrapper::Wrap(std::make_unique<SoftAVCDecoder>(), format);
+    auto softAVCDecoder = std::make_unique<SoftAVCDecoder>(GetSoftwareDecoderThreadCount());
+    videoDecoder = SoftwareDecoderWrapper::Wrap(std::move(softAVCDecoder), format);
     if (videoDecoder != nullptr) {
       LOGI("All other video decoders are not available, fallback to SoftAVCDecoder!");
     }
@@ -55,6 +55,11 @@ class VideoDecoder {
    */
   static int GetMaxHardwareDecoderCount();
 
+  /**
+   * Returns the number of threads the built-in software video decoder can use to decode one frame.
+   */
+  static int GetSoftwareDecoderThreadCount();
+
   /**
    * Creates a new video decoder by specified type. Returns a hardware video decoder if useHardware
    * is true, otherwise, returns a software video decoder.
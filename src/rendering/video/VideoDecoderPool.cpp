@@ -0,0 +1,142 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2021 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "VideoDecoderPool.h"
+#include <cstring>
+#include "tgfx/core/Clock.h"
+
+namespace pag {
+#define MAX_IDLE_DECODER_COUNT 4
+#define MAX_DECODER_IDLE_TIME 3000000  // 3s
+
+static bool IsSameData(const std::shared_ptr<tgfx::Data>& a, const std::shared_ptr<tgfx::Data>& b) {
+  if (a == b) {
+    return true;
+  }
+  if (a == nullptr || b == nullptr || a->size() != b->size()) {
+    return false;
+  }
+  return memcmp(a->data(), b->data(), a->size()) == 0;
+}
+
+static bool IsSameFormat(const VideoFormat& a, const VideoFormat& b) {
+  if (a.mimeType != b.mimeType || a.width != b.width || a.height != b.height ||
+      a.colorSpace != b.colorSpace || a.colorRange != b.colorRange ||
+      a.maxReorderSize != b.maxReorderSize || a.headers.size() != b.headers.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < a.headers.size(); i++) {
+    if (!IsSameData(a.headers[i], b.headers[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+VideoDecoderPool* VideoDecoderPool::Get() {
+  static auto& pool = *new VideoDecoderPool();
+  return &pool;
+}
+
+std::unique_ptr<VideoDecoder> VideoDecoderPool::Make(const VideoFormat& format, bool useHardware) {
+  auto pool = Get();
+  auto decoder = pool->obtain(format, useHardware);
+  if (decoder != nullptr) {
+    return decoder;
+  }
+  decoder = VideoDecoder::Make(format, useHardware);
+  // Idle hardware decoders still count towards the maximum hardware decoder count, release them
+  // to make room for the new one.
+  if (decoder == nullptr && useHardware && pool->releaseHardwareDecoders()) {
+    decoder = VideoDecoder::Make(format, useHardware);
+  }
+  return decoder;
+}
+
+void VideoDecoderPool::Recycle(const VideoFormat& format, std::unique_ptr<VideoDecoder> decoder) {
+  if (decoder == nullptr) {
+    return;
+  }
+  decoder->onFlush();
+  Get()->recycle(format, std::move(decoder));
+}
+
+void VideoDecoderPool::PurgeExpired() {
+  Get()->purge(MAX_DECODER_IDLE_TIME);
+}
+
+void VideoDecoderPool::PurgeAll() {
+  Get()->purge(0);
+}
+
+std::unique_ptr<VideoDecoder> VideoDecoderPool::obtain(const VideoFormat& format,
+                                                       bool useHardware) {
+  std::lock_guard<std::mutex> autoLock(locker);
+  for (auto iter = idleDecoders.begin(); iter != idleDecoders.end(); iter++) {
+    if (iter->decoder->isHardwareBacked() == useHardware && IsSameFormat(iter->format, format)) {
+      auto decoder = std::move(iter->decoder);
+      idleDecoders.erase(iter);
+      return decoder;
+    }
+  }
+  return nullptr;
+}
+
+void VideoDecoderPool::recycle(const VideoFormat& format, std::unique_ptr<VideoDecoder> decoder) {
+  std::unique_ptr<VideoDecoder> expiredDecoder = nullptr;
+  {
+    std::lock_guard<std::mutex> autoLock(locker);
+    if (idleDecoders.size() >= MAX_IDLE_DECODER_COUNT) {
+      expiredDecoder = std::move(idleDecoders.front().decoder);
+      idleDecoders.pop_front();
+    }
+    idleDecoders.push_back({format, std::move(decoder), tgfx::Clock::Now()});
+  }
+  // The expired decoder is released outside of the lock, which may take a while.
+}
+
+bool VideoDecoderPool::releaseHardwareDecoders() {
+  std::list<IdleDecoder> hardwareDecoders = {};
+  {
+    std::lock_guard<std::mutex> autoLock(locker);
+    for (auto iter = idleDecoders.begin(); iter != idleDecoders.end();) {
+      if (iter->decoder->isHardwareBacked()) {
+        hardwareDecoders.push_back(std::move(*iter));
+        iter = idleDecoders.erase(iter);
+      } else {
+        iter++;
+      }
+    }
+  }
+  return !hardwareDecoders.empty();
+}
+
+void VideoDecoderPool::purge(int64_t idleTime) {
+  std::list<IdleDecoder> expiredDecoders = {};
+  {
+    std::lock_guard<std::mutex> autoLock(locker);
+    auto now = tgfx::Clock::Now();
+    // Decoders are appended in the order they become idle, so the oldest ones are at the front.
+    while (!idleDecoders.empty() && now - idleDecoders.front().idleSince >= idleTime) {
+      expiredDecoders.push_back(std::move(idleDecoders.front()));
+      idleDecoders.pop_front();
+    }
+  }
+  // The expired decoders are released outside of the lock, which may take a while.
+}
+}  // namespace pag
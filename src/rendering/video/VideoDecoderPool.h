@@ -0,0 +1,74 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2021 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <list>
+#include <mutex>
+#include "VideoDecoder.h"
+
+namespace pag {
+/**
+ * VideoDecoderPool keeps the decoders released by VideoReaders and hands them out again to
+ * readers of the same video format, so that the initialization cost of a decoder is only paid
+ * once for many short video sequences. Decoders are flushed before they enter the pool, and are
+ * released if they stay idle for too long.
+ */
+class VideoDecoderPool {
+ public:
+  /**
+   * Returns an idle decoder of the specified format and type from the pool, or creates a new one
+   * if there is none. Returns nullptr if a new decoder can not be created.
+   */
+  static std::unique_ptr<VideoDecoder> Make(const VideoFormat& format, bool useHardware);
+
+  /**
+   * Returns the decoder back to the pool for reuse. The oldest idle decoder is released if the
+   * pool is full.
+   */
+  static void Recycle(const VideoFormat& format, std::unique_ptr<VideoDecoder> decoder);
+
+  /**
+   * Releases the decoders that have stayed in the pool for longer than the idle expiry time. This
+   * is called after every frame is rendered, so the idle decoders are released soon after videos
+   * stop playing.
+   */
+  static void PurgeExpired();
+
+  /**
+   * Releases all the idle decoders immediately, which can be called to reduce memory pressure.
+   */
+  static void PurgeAll();
+
+ private:
+  struct IdleDecoder {
+    VideoFormat format = {};
+    std::unique_ptr<VideoDecoder> decoder = nullptr;
+    int64_t idleSince = 0;
+  };
+
+  std::mutex locker = {};
+  std::list<IdleDecoder> idleDecoders = {};
+
+  static VideoDecoderPool* Get();
+  std::unique_ptr<VideoDecoder> obtain(const VideoFormat& format, bool useHardware);
+  void recycle(const VideoFormat& format, std::unique_ptr<VideoDecoder> decoder);
+  bool releaseHardwareDecoders();
+  void purge(int64_t idleTime);
+};
+}  // namespace pag
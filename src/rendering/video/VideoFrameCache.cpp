@@ -0,0 +1,86 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2021 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "VideoFrameCache.h"
+
+namespace pag {
+static size_t MinFrameMemory(const VideoBuffer* buffer) {
+  // All cacheable frames are in the I420 format, the copy takes at least this many bytes.
+  return static_cast<size_t>(buffer->width()) * buffer->height() * 3 / 2;
+}
+
+VideoFrameCache::VideoFrameCache(size_t maxMemory) : maxMemory(maxMemory) {
+}
+
+std::shared_ptr<VideoBuffer> VideoFrameCache::find(int64_t sampleTime) {
+  for (auto& frame : frames) {
+    if (frame.sampleTime == sampleTime) {
+      hits++;
+      return frame.buffer;
+    }
+  }
+  misses++;
+  return nullptr;
+}
+
+void VideoFrameCache::add(int64_t sampleTime, const std::shared_ptr<VideoBuffer>& buffer) {
+  if (buffer == nullptr || contains(sampleTime)) {
+    return;
+  }
+  if (MinFrameMemory(buffer.get()) > maxMemory) {
+    return;
+  }
+  auto copy = buffer->makeCopy();
+  if (copy == nullptr) {
+    return;
+  }
+  // Count the allocated size of the copy, which includes the row padding of the decoder output.
+  auto memory = copy->memoryUsage();
+  if (memory > maxMemory) {
+    return;
+  }
+  while (!frames.empty() && usedMemory + memory > maxMemory) {
+    usedMemory -= frames.front().memory;
+    frames.pop_front();
+  }
+  frames.push_back({sampleTime, std::move(copy), memory});
+  usedMemory += memory;
+}
+
+void VideoFrameCache::clear() {
+  frames.clear();
+  usedMemory = 0;
+}
+
+float VideoFrameCache::hitRate() const {
+  auto total = hits + misses;
+  if (total == 0) {
+    return 0;
+  }
+  return static_cast<float>(hits) / static_cast<float>(total);
+}
+
+bool VideoFrameCache::contains(int64_t sampleTime) const {
+  for (auto& frame : frames) {
+    if (frame.sampleTime == sampleTime) {
+      return true;
+    }
+  }
+  return false;
+}
+}  // namespace pag
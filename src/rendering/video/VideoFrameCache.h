@@ -0,0 +1,91 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2021 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <deque>
+#include "VideoBuffer.h"
+
+namespace pag {
+/**
+ * VideoFrameCache keeps a bounded ring of recently decoded video frames, so that backward or
+ * repeated seeks to nearby frames can be served without flushing and re-decoding from the previous
+ * key frame. The oldest frames are dropped first once the memory budget is exceeded.
+ */
+class VideoFrameCache {
+ public:
+  explicit VideoFrameCache(size_t maxMemory);
+
+  /**
+   * Returns the cached frame at the specified sample time, or nullptr if it is not cached.
+   */
+  std::shared_ptr<VideoBuffer> find(int64_t sampleTime);
+
+  /**
+   * Stores a copy of the specified frame. Does nothing if the frame can not be copied or the copy
+   * is larger than the memory budget.
+   */
+  void add(int64_t sampleTime, const std::shared_ptr<VideoBuffer>& buffer);
+
+  /**
+   * Removes all cached frames.
+   */
+  void clear();
+
+  /**
+   * Returns the number of frames found in the cache.
+   */
+  int64_t hitCount() const {
+    return hits;
+  }
+
+  /**
+   * Returns the number of frames not found in the cache.
+   */
+  int64_t missCount() const {
+    return misses;
+  }
+
+  /**
+   * Returns the ratio of hits to total lookups, or 0 if there is no lookup yet.
+   */
+  float hitRate() const;
+
+  /**
+   * Returns the memory usage of all cached frames in bytes.
+   */
+  size_t memoryUsage() const {
+    return usedMemory;
+  }
+
+ private:
+  struct CachedFrame {
+    int64_t sampleTime = 0;
+    std::shared_ptr<VideoBuffer> buffer = nullptr;
+    size_t memory = 0;
+  };
+
+  size_t maxMemory = 0;
+  size_t usedMemory = 0;
+  int64_t hits = 0;
+  int64_t misses = 0;
+  std::deque<CachedFrame> frames = {};
+
+  bool contains(int64_t sampleTime) const;
+};
+}  // namespace pag
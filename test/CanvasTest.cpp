@@ -18,11 +18,13 @@
 
 #include "framework/pag_test.h"
 #include "framework/utils/PAGTestUtils.h"
+#include "gpu/GradientCache.h"
 #include "tgfx/core/Image.h"
 #include "tgfx/core/PathEffect.h"
 #include "tgfx/gpu/Surface.h"
 #include "tgfx/gpu/opengl/GLDevice.h"
 #include "tgfx/gpu/opengl/GLFunctions.h"
+#include "tgfx/gpu/opengl/GLRenderTarget.h"
 #include "tgfx/gpu/opengl/GLTexture.h"
 
 namespace tgfx {
@@ -227,4 +229,52 @@ PAG_TEST(CanvasTest, TileMode) {
   EXPECT_TRUE(Compare(surface.get(), "CanvasTest/tileMode"));
   device->unlock();
 }
+
+/**
+ * 用例描述: 测试相同尺寸的 Surface 释放后再次创建时复用帧缓冲对象。
+ */
+PAG_TEST(CanvasTest, RecycleRenderTarget) {
+  auto device = GLDevice::Make();
+  auto context = device->lockContext();
+  ASSERT_TRUE(context != nullptr);
+  auto surface = Surface::Make(context, 100, 100);
+  ASSERT_TRUE(surface != nullptr);
+  auto renderTarget = std::static_pointer_cast<GLRenderTarget>(surface->getRenderTarget());
+  auto frameBufferID = renderTarget->glFrameBuffer().id;
+  renderTarget = nullptr;
+  surface = nullptr;
+  surface = Surface::Make(context, 100, 100);
+  ASSERT_TRUE(surface != nullptr);
+  renderTarget = std::static_pointer_cast<GLRenderTarget>(surface->getRenderTarget());
+  EXPECT_EQ(renderTarget->glFrameBuffer().id, frameBufferID);
+  surface = Surface::Make(context, 100, 100);
+  ASSERT_TRUE(surface != nullptr);
+  auto otherTarget = std::static_pointer_cast<GLRenderTarget>(surface->getRenderTarget());
+  EXPECT_NE(otherTarget->glFrameBuffer().id, frameBufferID);
+  device->unlock();
+}
+
+/**
+ * 用例描述: 测试多色渐变共享同一张渐变图集，超出容量时复用最久未使用的行。
+ */
+PAG_TEST(CanvasTest, GradientAtlas) {
+  auto device = GLDevice::Make();
+  auto context = device->lockContext();
+  ASSERT_TRUE(context != nullptr);
+  auto gradientCache = context->gradientCache();
+  float positions[] = {0.0f, 0.5f, 1.0f};
+  Color colors[] = {Color::Black(), Color::White(), Color::Black()};
+  float firstY = 0.0f;
+  auto atlas = gradientCache->getGradient(colors, positions, 3, &firstY);
+  ASSERT_TRUE(atlas != nullptr);
+  for (int i = 1; i < 40; i++) {
+    colors[1] = Color::FromRGBA(static_cast<uint8_t>(i), 0, 0);
+    float y = 0.0f;
+    EXPECT_EQ(gradientCache->getGradient(colors, positions, 3, &y), atlas);
+    EXPECT_GT(y, 0.0f);
+    EXPECT_LT(y, 1.0f);
+  }
+  EXPECT_EQ(gradientCache->rows.size(), static_cast<size_t>(atlas->height()));
+  device->unlock();
+}
 }  // namespace tgfx
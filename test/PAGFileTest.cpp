@@ -562,6 +562,153 @@ PAG_TEST(PAGFileVerticalTextCodec, VerticalTextCodec) {
   EXPECT_NE(static_cast<int>(byteData->length()), 0);
 }
 
+/**
+ * 用例描述: 压缩编码测试，压缩后的文件更小且解码后重新编码的数据与原文件一致
+ */
+PAG_TEST(PAGFileCompressedCodec, CompressedCodec) {
+  auto testFile = PAGFile::Load("../resources/apitest/test.pag");
+  ASSERT_NE(testFile, nullptr);
+  auto performanceData = std::make_shared<PerformanceData>();
+  performanceData->renderingTime = 100;
+  performanceData->graphicsMemory = 200;
+  auto byteData = Codec::Encode(testFile->getFile(), performanceData);
+  ASSERT_NE(byteData, nullptr);
+  auto compressedData = Codec::Encode(testFile->getFile(), performanceData, true);
+  ASSERT_NE(compressedData, nullptr);
+  EXPECT_LT(compressedData->length(), byteData->length());
+
+  auto file = Codec::Decode(compressedData->data(), static_cast<uint32_t>(compressedData->length()),
+                            "");
+  ASSERT_NE(file, nullptr);
+  auto reencodedData = Codec::Encode(file, performanceData);
+  ASSERT_EQ(reencodedData->length(), byteData->length());
+  EXPECT_EQ(memcmp(reencodedData->data(), byteData->data(), byteData->length()), 0);
+
+  auto data = Codec::ReadPerformanceData(compressedData->data(),
+                                         static_cast<uint32_t>(compressedData->length()));
+  ASSERT_NE(data, nullptr);
+  EXPECT_EQ(data->renderingTime, 100);
+  EXPECT_EQ(data->graphicsMemory, 200);
+}
+
+/**
+ * 用例描述: 带标签索引的编码测试，可以直接读取性能数据和文件属性，且不影响完整解码
+ */
+PAG_TEST(PAGFileTagIndexCodec, TagIndexCodec) {
+  auto testFile = PAGFile::Load("../resources/apitest/test.pag");
+  ASSERT_NE(testFile, nullptr);
+  auto file = testFile->getFile();
+  file->fileAttributes.author = "libpag";
+  auto performanceData = std::make_shared<PerformanceData>();
+  performanceData->renderingTime = 100;
+  auto byteData = Codec::Encode(file, performanceData);
+  ASSERT_NE(byteData, nullptr);
+  for (auto compressed : {false, true}) {
+    auto indexedData = Codec::Encode(file, performanceData, compressed, true);
+    ASSERT_NE(indexedData, nullptr);
+    auto length = static_cast<uint32_t>(indexedData->length());
+    auto data = Codec::ReadPerformanceData(indexedData->data(), length);
+    ASSERT_NE(data, nullptr);
+    EXPECT_EQ(data->renderingTime, 100);
+    auto fileAttributes = Codec::ReadFileAttributes(indexedData->data(), length);
+    ASSERT_NE(fileAttributes, nullptr);
+    EXPECT_EQ(fileAttributes->author, "libpag");
+
+    auto decodedFile = Codec::Decode(indexedData->data(), length, "");
+    ASSERT_NE(decodedFile, nullptr);
+    auto reencodedData = Codec::Encode(decodedFile, performanceData);
+    ASSERT_EQ(reencodedData->length(), byteData->length());
+    EXPECT_EQ(memcmp(reencodedData->data(), byteData->data(), byteData->length()), 0);
+  }
+  auto fileAttributes =
+      Codec::ReadFileAttributes(byteData->data(), static_cast<uint32_t>(byteData->length()));
+  ASSERT_NE(fileAttributes, nullptr);
+  EXPECT_EQ(fileAttributes->author, "libpag");
+}
+
+/**
+ * 用例描述: 文件按内容缓存，相同内容的图片共用uniqueID
+ */
+PAG_TEST(PAGFileContentCache, ContentCache) {
+  auto byteData = ByteData::FromPath("../resources/apitest/test.pag");
+  ASSERT_NE(byteData, nullptr);
+  auto file = File::Load(byteData->data(), byteData->length());
+  ASSERT_NE(file, nullptr);
+  ASSERT_FALSE(file->images.empty());
+  // 没有设置缓存大小时不按内容缓存。
+  EXPECT_NE(File::Load(byteData->data(), byteData->length()), file);
+
+  auto otherFile = File::Load(byteData->data(), byteData->length(), "ContentCache/test.pag");
+  ASSERT_NE(otherFile, nullptr);
+  ASSERT_NE(otherFile, file);
+  ASSERT_EQ(otherFile->images.size(), file->images.size());
+  for (size_t i = 0; i < file->images.size(); i++) {
+    EXPECT_EQ(otherFile->images[i]->uniqueID, file->images[i]->uniqueID);
+    EXPECT_EQ(otherFile->images[i]->fileBytes->data(), file->images[i]->fileBytes->data());
+  }
+
+  auto imageBytes = file->images.front()->fileBytes;
+  auto imageCopy = ByteData::MakeCopy(imageBytes->data(), imageBytes->length());
+  std::weak_ptr<File> weakFile = file;
+  file = nullptr;
+  // 图片数据通过引用计数共享，不会延长 file 的生命周期。
+  EXPECT_TRUE(weakFile.expired());
+  imageBytes = otherFile->images.front()->fileBytes;
+  ASSERT_EQ(imageBytes->length(), imageCopy->length());
+  EXPECT_EQ(memcmp(imageBytes->data(), imageCopy->data(), imageCopy->length()), 0);
+  otherFile = nullptr;
+
+  // 按内容缓存时会保留一份原始数据，计入缓存大小。
+  File::SetMaxCacheSize(byteData->length() * 2);
+  file = File::Load(byteData->data(), byteData->length());
+  EXPECT_EQ(File::Load(byteData->data(), byteData->length()), file);
+  weakFile = file;
+  file = nullptr;
+  EXPECT_FALSE(weakFile.expired());
+  EXPECT_EQ(File::Load(byteData->data(), byteData->length()), weakFile.lock());
+  File::SetMaxCacheSize(byteData->length());
+  EXPECT_TRUE(weakFile.expired());
+  File::SetMaxCacheSize(0);
+}
+
+/**
+ * 用例描述: 共享图片数据的文件在原文件释放后仍可正常渲染
+ */
+PAG_TEST(PAGFileContentCache, RenderSharedImages) {
+  auto byteData = ByteData::FromPath("../resources/apitest/test.pag");
+  ASSERT_NE(byteData, nullptr);
+  auto pagFile = PAGFile::Load(byteData->data(), byteData->length(), "ContentCache/owner.pag");
+  ASSERT_NE(pagFile, nullptr);
+  auto sharedFile = PAGFile::Load(byteData->data(), byteData->length(), "ContentCache/shared.pag");
+  ASSERT_NE(sharedFile, nullptr);
+  ASSERT_NE(sharedFile->getFile(), pagFile->getFile());
+  auto pagSurface = PAGSurface::MakeOffscreen(sharedFile->width(), sharedFile->height());
+  ASSERT_NE(pagSurface, nullptr);
+  auto pagPlayer = std::make_shared<PAGPlayer>();
+  pagPlayer->setSurface(pagSurface);
+  pagPlayer->setComposition(sharedFile);
+  pagPlayer->setProgress(0.5);
+  ASSERT_TRUE(pagPlayer->flush());
+  auto expected = MakeSnapshot(pagSurface);
+  ASSERT_NE(expected, nullptr);
+
+  std::weak_ptr<File> weakFile = pagFile->getFile();
+  pagFile = nullptr;
+  EXPECT_TRUE(weakFile.expired());
+  // 清空缓存，强制重新解码 sharedFile 的图片。
+  pagSurface->freeCache();
+  pagPlayer->setProgress(0.5);
+  ASSERT_TRUE(pagPlayer->flush());
+  auto actual = MakeSnapshot(pagSurface);
+  ASSERT_NE(actual, nullptr);
+  ASSERT_EQ(actual->byteSize(), expected->byteSize());
+  auto expectedPixels = expected->lockPixels();
+  auto actualPixels = actual->lockPixels();
+  EXPECT_EQ(memcmp(actualPixels, expectedPixels, actual->byteSize()), 0);
+  actual->unlockPixels();
+  expected->unlockPixels();
+}
+
 /**
  * 用例描述: ShapeType测试
  */
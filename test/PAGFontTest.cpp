@@ -22,6 +22,7 @@
 #include "framework/pag_test.h"
 #include "framework/utils/PAGTestUtils.h"
 #include "nlohmann/json.hpp"
+#include "rendering/FontManager.h"
 
 namespace pag {
 using nlohmann::json;
@@ -57,4 +58,23 @@ PAG_TEST(PAGFontTest, TestFont) {
   EXPECT_EQ(errorMsg, "") << "test_font frame fail";
 }
 
+/**
+ * 用例描述: 回退字体按字符缓存查找结果，重复查找返回相同的字体和字形
+ */
+PAG_TEST(PAGFontTest, FallbackGlyphCache) {
+  tgfx::GlyphID glyphID = 0;
+  auto typeface = FontManager::GetFallbackTypeface("测", &glyphID);
+  ASSERT_NE(typeface, nullptr);
+  EXPECT_NE(glyphID, 0);
+  tgfx::GlyphID cachedGlyphID = 0;
+  auto cachedTypeface = FontManager::GetFallbackTypeface("测", &cachedGlyphID);
+  EXPECT_EQ(cachedTypeface, typeface);
+  EXPECT_EQ(cachedGlyphID, glyphID);
+  // 不存在于任何回退字体中的字符返回默认字体。
+  tgfx::GlyphID missingGlyphID = 1;
+  auto defaultTypeface = FontManager::GetFallbackTypeface("\U0010FFFD", &missingGlyphID);
+  EXPECT_NE(defaultTypeface, nullptr);
+  EXPECT_EQ(missingGlyphID, 0);
+}
+
 }  // namespace pag
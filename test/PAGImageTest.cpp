@@ -167,4 +167,28 @@ PAG_TEST_F(PAGImageTest, BottomLeftMask) {
   device->unlock();
   EXPECT_TRUE(Baseline::Compare(bitmap, "PAGImageTest/BottomLeftMask"));
 }
+
+/**
+ * 用例描述: 按缩放值降采样解码 JPEG、PNG 和 WEBP 图片
+ */
+PAG_TEST_F(PAGImageTest, ScaledDecode) {
+  std::vector<std::string> paths = {"../resources/apitest/rotation.jpg",
+                                    "../resources/apitest/imageReplacement.png",
+                                    "../resources/apitest/imageReplacement.webp"};
+  for (auto& path : paths) {
+    auto image = Image::MakeFrom(path);
+    ASSERT_TRUE(image != nullptr);
+    auto fullBuffer = image->makeBuffer(1.0f);
+    ASSERT_TRUE(fullBuffer != nullptr);
+    EXPECT_EQ(fullBuffer->width(), image->width());
+    EXPECT_EQ(fullBuffer->height(), image->height());
+    auto scaleFactor = 0.3f;
+    auto buffer = image->makeBuffer(scaleFactor);
+    ASSERT_TRUE(buffer != nullptr);
+    EXPECT_GE(static_cast<float>(buffer->width()), image->width() * scaleFactor);
+    EXPECT_GE(static_cast<float>(buffer->height()), image->height() * scaleFactor);
+    EXPECT_LT(buffer->width(), image->width());
+    EXPECT_LT(buffer->height(), image->height());
+  }
+}
 }  // namespace pag
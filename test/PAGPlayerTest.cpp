@@ -19,6 +19,8 @@
 #include "framework/pag_test.h"
 #include "framework/utils/PAGTestUtils.h"
 #include "nlohmann/json.hpp"
+#include "rendering/caches/RenderCache.h"
+#include "rendering/utils/Tracer.h"
 
 namespace pag {
 using nlohmann::json;
@@ -131,4 +133,110 @@ PAG_TEST_F(PAGPlayerTest, autoClear) {
   EXPECT_TRUE(Baseline::Compare(pagSurface, "PAGPlayerTest/autoClear_autoClear_true"));
 }
 
-}  // namespace pag
\ No newline at end of file
+/**
+ * 用例描述: 开启 PAGTrace 后渲染一帧，导出的数据为 Chrome trace-event 格式并包含图层信息
+ */
+PAG_TEST(PAGPlayerTest, TraceExport) {
+  auto pagFile = PAGFile::Load("../resources/apitest/test.pag");
+  ASSERT_NE(pagFile, nullptr);
+  auto pagSurface = PAGSurface::MakeOffscreen(pagFile->width(), pagFile->height());
+  auto pagPlayer = std::make_shared<PAGPlayer>();
+  pagPlayer->setSurface(pagSurface);
+  pagPlayer->setComposition(pagFile);
+  PAGTrace::Clear();
+  PAGTrace::SetEnabled(true);
+  pagPlayer->setProgress(0.5);
+  pagPlayer->flush();
+  PAGTrace::SetEnabled(false);
+  auto trace = json::parse(PAGTrace::ExportJSON());
+  auto& events = trace["traceEvents"];
+  ASSERT_TRUE(events.is_array());
+  bool hasFrame = false;
+  bool hasLayer = false;
+  for (auto& event : events) {
+    EXPECT_EQ(event["ph"], "X");
+    if (event["name"] == "PAGPlayer::flush") {
+      hasFrame = true;
+    }
+    if (event.contains("args") && event["args"]["layerID"].get<int>() > 0) {
+      hasLayer = true;
+    }
+  }
+  EXPECT_TRUE(hasFrame);
+  EXPECT_TRUE(hasLayer);
+  PAGTrace::Clear();
+  EXPECT_EQ(json::parse(PAGTrace::ExportJSON())["traceEvents"].size(), 0u);
+
+  // 超长的中文图层名被截断后仍然是合法的 UTF-8。
+  SolidLayer layer = {};
+  layer.id = 1;
+  layer.name = "中文图层名称中文图层名称中文图层名称";
+  PAGTrace::SetEnabled(true);
+  { TRACE_LAYER_SPAN("TraceExport", &layer); }
+  PAGTrace::SetEnabled(false);
+  trace = json::parse(PAGTrace::ExportJSON());
+  ASSERT_EQ(trace["traceEvents"].size(), 1u);
+  auto layerName = trace["traceEvents"][0]["args"]["layerName"].get<std::string>();
+  EXPECT_EQ(layerName, "中文图层名称中文图层");
+  PAGTrace::Clear();
+}
+
+/**
+ * 用例描述: 渲染 PAGFile 时按 MemoryCalculator 的逐帧预测给出显存预测值和清理阈值
+ */
+PAG_TEST(PAGPlayerTest, PredictedGraphicsMemory) {
+  auto pagFile = PAGFile::Load("../resources/apitest/test.pag");
+  ASSERT_NE(pagFile, nullptr);
+  auto pagSurface = PAGSurface::MakeOffscreen(pagFile->width(), pagFile->height());
+  auto pagPlayer = std::make_shared<PAGPlayer>();
+  pagPlayer->setSurface(pagSurface);
+  pagPlayer->setComposition(pagFile);
+  pagPlayer->setProgress(0.5);
+  pagPlayer->flush();
+  auto renderCache = pagPlayer->renderCache;
+  // 显存预测在异步线程计算，等待计算完成后再绘制一帧。
+  if (renderCache->predictorTask != nullptr) {
+    renderCache->predictorTask->wait();
+  }
+  pagPlayer->setProgress(0.6);
+  pagPlayer->flush();
+  ASSERT_NE(renderCache->memoryPredictor, nullptr);
+  EXPECT_EQ(renderCache->memoryPredictor->duration(), pagFile->getFile()->duration());
+  EXPECT_GT(pagPlayer->predictedGraphicsMemory(), 0);
+  EXPECT_GE(renderCache->purgeableMemory(), static_cast<size_t>(20971520));
+  EXPECT_LE(renderCache->purgeableMemory(), static_cast<size_t>(314572800));
+
+  pagPlayer->setComposition(PAGComposition::Make(pagFile->width(), pagFile->height()));
+  pagPlayer->flush();
+  EXPECT_EQ(renderCache->memoryPredictor, nullptr);
+  EXPECT_EQ(pagPlayer->predictedGraphicsMemory(), 0);
+}
+
+/**
+ * 用例描述: PAGPlayer.warmUp() 提前编译滤镜程序，并在首帧绘制时复用
+ */
+PAG_TEST(PAGPlayerTest, WarmUp) {
+  auto pagFile = PAGFile::Load("../resources/filter/MotionBlur.pag");
+  ASSERT_NE(pagFile, nullptr);
+  auto pagPlayer = std::make_shared<PAGPlayer>();
+  pagPlayer->setComposition(pagFile);
+  EXPECT_FALSE(pagPlayer->warmUp());
+  auto pagSurface = PAGSurface::MakeOffscreen(pagFile->width(), pagFile->height());
+  pagPlayer->setSurface(pagSurface);
+  EXPECT_TRUE(pagPlayer->warmUp());
+  auto renderCache = pagPlayer->renderCache;
+  auto motionBlurFilter = renderCache->motionBlurFilter;
+  EXPECT_NE(motionBlurFilter, nullptr);
+  EXPECT_GT(renderCache->programCompilingTime, 0);
+  pagPlayer->setProgress(0.5);
+  EXPECT_TRUE(pagPlayer->flush());
+  EXPECT_EQ(renderCache->motionBlurFilter, motionBlurFilter);
+
+  // 播放过程中预热不会清理正在使用的缓存。
+  auto memoryUsage = renderCache->memoryUsage();
+  auto snapshotCount = renderCache->snapshotLRU.size();
+  EXPECT_TRUE(pagPlayer->warmUp());
+  EXPECT_EQ(renderCache->memoryUsage(), memoryUsage);
+  EXPECT_EQ(renderCache->snapshotLRU.size(), snapshotCount);
+}
+}  // namespace pag
@@ -22,6 +22,8 @@
 #include "pag/pag.h"
 #include "platform/swiftshader/NativePlatform.h"
 #include "rendering/caches/RenderCache.h"
+#include "rendering/sequences/VideoReader.h"
+#include "rendering/video/VideoDecoderPool.h"
 
 namespace pag {
 
@@ -121,4 +123,60 @@ PAG_TEST_F(PAGSequenceTest, VideoSequenceToMP4WithoutHeader) {
       Baseline::Compare(std::move(MP4Data), "PAGSequenceTest/VideoSequenceToMP4WithoutHeader"));
 }
 
+/**
+ * 用例描述: 视频序列帧回退到最近解码过的帧时直接命中缓存，不需要重新解码
+ */
+PAG_TEST_F(PAGSequenceTest, VideoFrameCache) {
+  auto pagFile = PAGFile::Load("../resources/apitest/video_sequence_test.pag");
+  ASSERT_NE(pagFile, nullptr);
+  auto pagSurface = PAGSurface::MakeOffscreen(pagFile->width(), pagFile->height());
+  auto pagPlayer = std::make_shared<PAGPlayer>();
+  pagPlayer->setSurface(pagSurface);
+  pagPlayer->setComposition(pagFile);
+  pagPlayer->setProgress(0.5);
+  pagPlayer->flush();
+  pagPlayer->setProgress(0.6);
+  pagPlayer->flush();
+  pagPlayer->setProgress(0.5);
+  pagPlayer->flush();
+  pagPlayer->setProgress(0.6);
+  pagPlayer->flush();
+  pagPlayer->setProgress(0.5);
+  pagPlayer->flush();
+  auto& sequenceCaches = pagPlayer->renderCache->sequenceCaches;
+  ASSERT_EQ(static_cast<int>(sequenceCaches.size()), 1);
+  auto reader = std::static_pointer_cast<VideoReader>(sequenceCaches.begin()->second);
+  auto frameCache = reader->getFrameCache();
+  EXPECT_GT(frameCache->hitCount(), 0);
+  EXPECT_GT(frameCache->memoryUsage(), 0u);
+}
+
+/**
+ * 用例描述: 视频序列帧销毁后解码器回收到复用池，下次渲染相同格式的视频时直接复用
+ */
+PAG_TEST_F(PAGSequenceTest, VideoDecoderPool) {
+  auto pagFile = PAGFile::Load("../resources/apitest/video_sequence_test.pag");
+  ASSERT_NE(pagFile, nullptr);
+  auto pagSurface = PAGSurface::MakeOffscreen(pagFile->width(), pagFile->height());
+  auto pagPlayer = std::make_shared<PAGPlayer>();
+  pagPlayer->setSurface(pagSurface);
+  pagPlayer->setComposition(pagFile);
+  pagPlayer->setProgress(0.5);
+  pagPlayer->flush();
+  auto pool = VideoDecoderPool::Get();
+  pool->idleDecoders.clear();
+  pagPlayer->renderCache->clearAllSequenceCaches();
+  EXPECT_EQ(static_cast<int>(pool->idleDecoders.size()), 1);
+  pagPlayer->setProgress(0.6);
+  pagPlayer->flush();
+  EXPECT_TRUE(pool->idleDecoders.empty());
+
+  pagPlayer->renderCache->clearAllSequenceCaches();
+  EXPECT_EQ(static_cast<int>(pool->idleDecoders.size()), 1);
+  VideoDecoderPool::PurgeExpired();
+  EXPECT_EQ(static_cast<int>(pool->idleDecoders.size()), 1);
+  pagSurface->freeCache();
+  EXPECT_TRUE(pool->idleDecoders.empty());
+}
+
 }  // namespace pag
@@ -21,6 +21,7 @@
 #include "gpu/opengl/GLCaps.h"
 #include "gpu/opengl/GLUtil.h"
 #include "rendering/Drawable.h"
+#include "rendering/graphics/HitTestMask.h"
 #include "tgfx/gpu/opengl/GLDevice.h"
 
 namespace pag {
@@ -142,4 +143,47 @@ PAG_TEST(PAGSurfaceTest, BottomLeftScissor) {
   gl->deleteTextures(1, &textureInfo.id);
   device->unlock();
 }
+
+/**
+ * 用例描述: 离屏 PAGSurface 共享 GPU 设备
+ */
+PAG_TEST(PAGSurfaceTest, SharedDevice) {
+  PAGSurface::SetMaxSharedDeviceCount(1);
+  auto pagFile = PAGFile::Load("../resources/apitest/test.pag");
+  auto surfaceA = PAGSurface::MakeOffscreen(pagFile->width(), pagFile->height(), true);
+  ASSERT_TRUE(surfaceA != nullptr);
+  auto surfaceB = PAGSurface::MakeOffscreen(pagFile->width(), pagFile->height(), true);
+  ASSERT_TRUE(surfaceB != nullptr);
+  EXPECT_EQ(surfaceA->drawable->getDevice(), surfaceB->drawable->getDevice());
+  auto pagPlayer = std::make_shared<PAGPlayer>();
+  pagPlayer->setComposition(pagFile);
+  pagPlayer->setSurface(surfaceA);
+  pagPlayer->setProgress(0.5);
+  EXPECT_TRUE(pagPlayer->flush());
+  pagPlayer->setSurface(surfaceB);
+  EXPECT_TRUE(pagPlayer->flush());
+  PAGSurface::SetMaxSharedDeviceCount(2);
+}
+
+/**
+ * 用例描述: 像素级碰撞检测使用缓存的降采样遮罩在 CPU 上完成判断
+ */
+PAG_TEST(PAGSurfaceTest, HitTestMask) {
+  auto device = GLDevice::Make();
+  auto context = device->lockContext();
+  ASSERT_TRUE(context != nullptr);
+  auto bounds = tgfx::Rect::MakeXYWH(100, 100, 1000, 500);
+  auto mask = HitTestMask::Make(context, bounds, [](Canvas* canvas) {
+    Paint paint;
+    paint.setColor(tgfx::Color::White());
+    canvas->drawRect(tgfx::Rect::MakeXYWH(100, 100, 500, 500), paint);
+  });
+  device->unlock();
+  ASSERT_TRUE(mask != nullptr);
+  EXPECT_LE(mask->width, 256);
+  EXPECT_TRUE(mask->hitTest(150, 300));
+  EXPECT_TRUE(mask->hitTest(580, 590));
+  EXPECT_FALSE(mask->hitTest(800, 300));
+  EXPECT_FALSE(mask->hitTest(50, 50));
+}
 }  // namespace pag
@@ -23,6 +23,7 @@
 #include "framework/utils/PAGTestUtils.h"
 #include "nlohmann/json.hpp"
 #include "pag/file.h"
+#include "rendering/caches/TextLayoutCache.h"
 #include "rendering/renderers/TextRenderer.h"
 
 namespace pag {
@@ -507,4 +508,23 @@ PAG_TEST_F(PAGTextLayerTest, TextRangeSelectorTriangleEarseHighAndLow) {
   EXPECT_TRUE(Baseline::Compare(TestPAGSurface, "PAGTextLayerTest/RangeSelectorTriangleHighLow"));
 }
 
+/**
+ * 用例描述: 排版相关属性相同的 TextDocument 复用同一份排版结果
+ */
+PAG_TEST(PAGTextLayerTest, TextLayoutCache) {
+  auto textDocument = std::make_shared<TextDocument>();
+  textDocument->text = "PAG 文本排版缓存";
+  textDocument->fontSize = 30;
+  auto layout = TextLayoutCache::GetLayout(textDocument.get(), nullptr);
+  ASSERT_NE(layout, nullptr);
+  EXPECT_FALSE(layout->lines.empty());
+  auto sameDocument = std::make_shared<TextDocument>(*textDocument);
+  // 背景色不影响排版结果。
+  sameDocument->backgroundAlpha = 255;
+  EXPECT_EQ(TextLayoutCache::GetLayout(sameDocument.get(), nullptr), layout);
+  auto otherDocument = std::make_shared<TextDocument>(*textDocument);
+  otherDocument->fontSize = 40;
+  EXPECT_NE(TextLayoutCache::GetLayout(otherDocument.get(), nullptr), layout);
+}
+
 }  // namespace pag
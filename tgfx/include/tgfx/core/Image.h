@@ -83,6 +83,15 @@ class Image {
    */
   virtual std::shared_ptr<TextureBuffer> makeBuffer() const;
 
+  /**
+   * Creates a new texture buffer capturing the pixels in this image, downsampled by the specified
+   * scale factor. The scaleFactor is clamped to (0, 1]. The dimensions of the returned buffer are
+   * never smaller than the image dimensions multiplied by the scaleFactor, but they may be larger
+   * if the decoder only supports some discrete scale steps. Returns the same result as
+   * makeBuffer() if the image can not be decoded at a reduced resolution.
+   */
+  std::shared_ptr<TextureBuffer> makeBuffer(float scaleFactor) const;
+
   /**
    * Decodes the image with the specified image info into the given pixels. Returns true if the
    * decoding was successful.
@@ -96,6 +105,21 @@ class Image {
       : _width(width), _height(height), _orientation(orientation) {
   }
 
+  /**
+   * Returns the dimensions that the image can be decoded to for the specified scale factor, which
+   * are never smaller than the image dimensions multiplied by the scaleFactor. Returns false if the
+   * image can not be decoded at a reduced resolution. The default implementation chooses an
+   * integer box filter step.
+   */
+  virtual bool getScaledDimensions(float scaleFactor, int* scaledWidth, int* scaledHeight) const;
+
+  /**
+   * Decodes the image downsampled to the dimensions of the specified image info into the given
+   * pixels. Returns true if the decoding was successful. The default implementation decodes the
+   * image at full resolution and then downsamples it with a box filter.
+   */
+  virtual bool readScaledPixels(const ImageInfo& dstInfo, void* dstPixels) const;
+
  private:
   int _width = 0;
   int _height = 0;
@@ -18,6 +18,7 @@
 
 #pragma once
 
+#include <condition_variable>
 #include <mutex>
 #include "tgfx/core/Matrix.h"
 
@@ -40,8 +41,10 @@ class Device {
   /**
    * Locks the rendering context associated with this device, if another thread has already locked
    * the device by lockContext(), a call to lockContext() will block execution until the device
-   * is available. The returned context can be used to draw graphics. A nullptr is returned If the
-   * context can not be locked on the calling thread, and leaves the device unlocked.
+   * is available. Blocked threads acquire the device in the order they called lockContext(), so
+   * a device shared by many threads is scheduled fairly. The returned context can be used to draw
+   * graphics. A nullptr is returned If the context can not be locked on the calling thread, and
+   * leaves the device unlocked.
    */
   Context* lockContext();
 
@@ -64,6 +67,12 @@ class Device {
  private:
   uint32_t _uniqueID = 0;
   bool contextLocked = false;
+  std::mutex queueLocker = {};
+  std::condition_variable queueCondition = {};
+  uint64_t nextTicket = 0;
+  uint64_t servingTicket = 0;
+
+  void lockInOrder();
 
   friend class ResourceCache;
 };
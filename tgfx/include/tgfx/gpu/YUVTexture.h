@@ -96,6 +96,14 @@ class YUVTexture : public Texture {
     return true;
   }
 
+  /**
+   * Replaces the pixels of this texture in place with the specified I420 buffers, which must have
+   * the same dimensions as this texture. This avoids reallocating the texture storage for every
+   * decoded video frame. The associated context must be locked. Returns false if the pixel format
+   * of this texture is not I420.
+   */
+  bool updateI420(uint8_t* pixelsPlane[3], const int lineSize[3]);
+
  private:
   YUVColorSpace _colorSpace = YUVColorSpace::Rec601;
   YUVColorRange _colorRange = YUVColorRange::MPEG;
@@ -58,6 +58,9 @@ class GLRenderTarget : public RenderTarget {
     return renderTargetFBInfo;
   }
 
+ protected:
+  void computeRecycleKey(BytesKey* recycleKey) const override;
+
  private:
   GLFrameBuffer textureFBInfo = {};
   GLFrameBuffer renderTargetFBInfo = {};
@@ -71,6 +74,9 @@ class GLRenderTarget : public RenderTarget {
    */
   static std::shared_ptr<GLRenderTarget> MakeFrom(const GLTexture* texture, int sampleCount = 1);
 
+  static void ComputeRecycleKey(BytesKey* recycleKey, int width, int height, ImageOrigin origin,
+                                int sampleCount, PixelFormat format, unsigned textureTarget);
+
   GLRenderTarget(int width, int height, ImageOrigin origin, int sampleCount,
                  GLFrameBuffer frameBuffer, unsigned textureTarget = 0);
 
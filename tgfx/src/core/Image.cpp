@@ -17,6 +17,8 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "tgfx/core/Image.h"
+#include <cmath>
+#include "core/utils/BoxDownsampler.h"
 #include "core/utils/USE.h"
 #include "platform/NativeCodec.h"
 #include "tgfx/core/Bitmap.h"
@@ -148,4 +150,52 @@ std::shared_ptr<TextureBuffer> Image::makeBuffer() const {
   auto result = readPixels(pixelBuffer->info(), bitmap.writablePixels());
   return result ? pixelBuffer : nullptr;
 }
+
+std::shared_ptr<TextureBuffer> Image::makeBuffer(float scaleFactor) const {
+  int scaledWidth = 0;
+  int scaledHeight = 0;
+  if (scaleFactor <= 0 || scaleFactor >= 1.0f ||
+      !getScaledDimensions(scaleFactor, &scaledWidth, &scaledHeight) ||
+      (scaledWidth >= width() && scaledHeight >= height())) {
+    return makeBuffer();
+  }
+  auto pixelBuffer = PixelBuffer::Make(scaledWidth, scaledHeight, false);
+  if (pixelBuffer == nullptr) {
+    return nullptr;
+  }
+  Bitmap bitmap(pixelBuffer);
+  if (!readScaledPixels(pixelBuffer->info(), bitmap.writablePixels())) {
+    bitmap.reset();
+    return makeBuffer();
+  }
+  return pixelBuffer;
+}
+
+bool Image::getScaledDimensions(float scaleFactor, int* scaledWidth, int* scaledHeight) const {
+  auto step = static_cast<int>(floorf(1.0f / scaleFactor));
+  if (step <= 1) {
+    return false;
+  }
+  *scaledWidth = (width() + step - 1) / step;
+  *scaledHeight = (height() + step - 1) / step;
+  return true;
+}
+
+bool Image::readScaledPixels(const ImageInfo& dstInfo, void* dstPixels) const {
+  if (dstPixels == nullptr || dstInfo.isEmpty()) {
+    return false;
+  }
+  auto srcInfo = ImageInfo::Make(width(), height(), dstInfo.colorType(), dstInfo.alphaType());
+  if (srcInfo.isEmpty()) {
+    return false;
+  }
+  auto srcPixels = new (std::nothrow) uint8_t[srcInfo.byteSize()];
+  if (srcPixels == nullptr) {
+    return false;
+  }
+  auto result = readPixels(srcInfo, srcPixels) &&
+                BoxDownsampler::Downsample(srcInfo, srcPixels, dstInfo, dstPixels);
+  delete[] srcPixels;
+  return result;
+}
 }  // namespace tgfx
\ No newline at end of file
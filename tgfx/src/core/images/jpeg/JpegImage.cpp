@@ -17,6 +17,7 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "core/images/jpeg/JpegImage.h"
+#include <cmath>
 #include <csetjmp>
 #include "core/utils/OrientationHelper.h"
 #include "tgfx/core/Bitmap.h"
@@ -106,12 +107,44 @@ std::shared_ptr<Image> JpegImage::MakeFromData(const std::string& filePath,
                                               filePath, std::move(byteData)));
 }
 
+// libjpeg-turbo supports DCT scaling with the factors of M/8, where M is in the range of [1, 8].
+static constexpr unsigned kDCTScaleDenom = 8;
+
+static int ScaledDimension(int dimension, unsigned scaleNum) {
+  return static_cast<int>((static_cast<unsigned>(dimension) * scaleNum + kDCTScaleDenom - 1) /
+                          kDCTScaleDenom);
+}
+
 bool JpegImage::readPixels(const ImageInfo& dstInfo, void* dstPixels) const {
+  return decode(dstInfo, dstPixels, kDCTScaleDenom);
+}
+
+bool JpegImage::getScaledDimensions(float scaleFactor, int* scaledWidth, int* scaledHeight) const {
+  auto scaleNum = static_cast<unsigned>(ceilf(scaleFactor * kDCTScaleDenom));
+  if (scaleNum == 0 || scaleNum >= kDCTScaleDenom) {
+    return false;
+  }
+  *scaledWidth = ScaledDimension(width(), scaleNum);
+  *scaledHeight = ScaledDimension(height(), scaleNum);
+  return true;
+}
+
+bool JpegImage::readScaledPixels(const ImageInfo& dstInfo, void* dstPixels) const {
+  for (unsigned scaleNum = 1; scaleNum <= kDCTScaleDenom; scaleNum++) {
+    if (ScaledDimension(width(), scaleNum) == dstInfo.width() &&
+        ScaledDimension(height(), scaleNum) == dstInfo.height()) {
+      return decode(dstInfo, dstPixels, scaleNum);
+    }
+  }
+  return Image::readScaledPixels(dstInfo, dstPixels);
+}
+
+bool JpegImage::decode(const ImageInfo& dstInfo, void* dstPixels, unsigned scaleNum) const {
   if (dstPixels == nullptr || dstInfo.isEmpty()) {
     return false;
   }
   if (dstInfo.colorType() == ColorType::ALPHA_8) {
-    memset(dstPixels, 255, dstInfo.rowBytes() * height());
+    memset(dstPixels, 255, dstInfo.rowBytes() * dstInfo.height());
     return true;
   }
   FILE* infile = nullptr;
@@ -136,10 +169,17 @@ bool JpegImage::readPixels(const ImageInfo& dstInfo, void* dstPixels) const {
     } else if (dstInfo.colorType() == ColorType::BGRA_8888) {
       cinfo.out_color_space = JCS_EXT_BGRA;
     }
+    cinfo.scale_num = scaleNum;
+    cinfo.scale_denom = kDCTScaleDenom;
     if (!jpeg_start_decompress(&cinfo)) break;
+    if (cinfo.output_width != static_cast<JDIMENSION>(dstInfo.width()) ||
+        cinfo.output_height != static_cast<JDIMENSION>(dstInfo.height())) {
+      jpeg_abort_decompress(&cinfo);
+      break;
+    }
     JSAMPROW pRow[1];
     int line = 0;
-    JDIMENSION h = height();
+    JDIMENSION h = cinfo.output_height;
     while (cinfo.output_scanline < h) {
       pRow[0] = (JSAMPROW)(static_cast<unsigned char*>(dstPixels) + dstInfo.rowBytes() * line);
       jpeg_read_scanlines(&cinfo, pRow, 1);
@@ -35,10 +35,16 @@ class JpegImage : public Image {
  protected:
   bool readPixels(const ImageInfo& dstInfo, void* dstPixels) const override;
 
+  bool getScaledDimensions(float scaleFactor, int* scaledWidth, int* scaledHeight) const override;
+
+  bool readScaledPixels(const ImageInfo& dstInfo, void* dstPixels) const override;
+
  private:
   std::shared_ptr<Data> fileData;
   const std::string filePath;
 
+  bool decode(const ImageInfo& dstInfo, void* dstPixels, unsigned scaleNum) const;
+
   static std::shared_ptr<Image> MakeFromData(const std::string& filePath,
                                              std::shared_ptr<Data> byteData);
   explicit JpegImage(int width, int height, Orientation orientation, std::string filePath,
@@ -17,6 +17,7 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "core/images/png/PngImage.h"
+#include "core/utils/BoxDownsampler.h"
 #include "png.h"
 #include "tgfx/core/Bitmap.h"
 #include "tgfx/core/Buffer.h"
@@ -188,6 +189,67 @@ bool PngImage::readPixels(const ImageInfo& dstInfo, void* dstPixels) const {
   }
 }
 
+static void PremultiplyRow(uint8_t* row, int width) {
+  for (int i = 0; i < width; i++) {
+    auto pixel = row + i * 4;
+    auto alpha = pixel[3];
+    if (alpha == 255) {
+      continue;
+    }
+    pixel[0] = static_cast<uint8_t>((pixel[0] * alpha + 127) / 255);
+    pixel[1] = static_cast<uint8_t>((pixel[1] * alpha + 127) / 255);
+    pixel[2] = static_cast<uint8_t>((pixel[2] * alpha + 127) / 255);
+  }
+}
+
+bool PngImage::readScaledPixels(const ImageInfo& dstInfo, void* dstPixels) const {
+  if (dstPixels == nullptr || dstInfo.isEmpty()) {
+    return false;
+  }
+  auto readInfo = ReadInfo::Make(filePath, fileData);
+  if (readInfo == nullptr) {
+    return false;
+  }
+  if (png_get_interlace_type(readInfo->p, readInfo->pi) != PNG_INTERLACE_NONE) {
+    // Interlaced images can not be decoded row by row.
+    return Image::readScaledPixels(dstInfo, dstPixels);
+  }
+  UpdateReadInfo(readInfo->p, readInfo->pi);
+  auto w = width();
+  auto h = height();
+  // Rows are premultiplied before averaging to keep transparent pixels from bleeding colors.
+  auto scaledInfo = ImageInfo::Make(dstInfo.width(), dstInfo.height(), ColorType::RGBA_8888,
+                                    AlphaType::Premultiplied);
+  auto directly = dstInfo.colorType() == ColorType::RGBA_8888 &&
+                  dstInfo.alphaType() == AlphaType::Premultiplied;
+  Buffer scaledBuffer(directly ? 0 : scaledInfo.byteSize());
+  auto scaledPixels = directly ? dstPixels : scaledBuffer.data();
+  if (scaledPixels == nullptr) {
+    return false;
+  }
+  if (directly) {
+    scaledInfo = dstInfo;
+  }
+  BoxDownsampler downsampler(w, h, scaledInfo, scaledPixels);
+  readInfo->data = (unsigned char*)malloc(w * 4);
+  if (!downsampler.isValid() || readInfo->data == nullptr) {
+    return false;
+  }
+  if (setjmp(png_jmpbuf(readInfo->p))) {
+    return false;
+  }
+  for (int i = 0; i < h; i++) {
+    png_read_row(readInfo->p, readInfo->data, nullptr);
+    PremultiplyRow(readInfo->data, w);
+    downsampler.addRow(readInfo->data);
+  }
+  if (directly) {
+    return true;
+  }
+  Bitmap bitmap(scaledInfo, scaledPixels);
+  return bitmap.readPixels(dstInfo, dstPixels);
+}
+
 #ifdef TGFX_USE_PNG_ENCODE
 struct PngWriter {
   unsigned char* data = nullptr;
@@ -35,6 +35,8 @@ class PngImage : public Image {
  protected:
   bool readPixels(const ImageInfo& dstInfo, void* dstPixels) const override;
 
+  bool readScaledPixels(const ImageInfo& dstInfo, void* dstPixels) const override;
+
  private:
   static std::shared_ptr<Image> MakeFromData(const std::string& filePath,
                                              std::shared_ptr<Data> byteData);
@@ -17,6 +17,7 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "core/images/webp/WebpImage.h"
+#include <cmath>
 #include "core/images/webp/WebpUtility.h"
 #include "tgfx/core/Bitmap.h"
 #include "tgfx/core/Buffer.h"
@@ -81,12 +82,20 @@ bool WebpImage::readPixels(const ImageInfo& dstInfo, void* dstPixels) const {
     return false;
   }
   config.output.is_external_memory = 1;
+  auto dstWidth = dstInfo.width();
+  auto dstHeight = dstInfo.height();
+  if (dstWidth != width() || dstHeight != height()) {
+    // WebP has a built-in scaler which downsamples the image during decoding.
+    config.options.use_scaling = 1;
+    config.options.scaled_width = dstWidth;
+    config.options.scaled_height = dstHeight;
+  }
   bool decodeSuccess = true;
   if (dstInfo.colorType() == ColorType::ALPHA_8) {
     // decode to RGBA_8888
     config.output.colorspace = webp_decode_mode(ColorType::RGBA_8888, false);
-    config.output.u.RGBA.stride = width() * ImageInfo::GetBytesPerPixel(ColorType::RGBA_8888);
-    config.output.u.RGBA.size = config.output.u.RGBA.stride * height();
+    config.output.u.RGBA.stride = dstWidth * ImageInfo::GetBytesPerPixel(ColorType::RGBA_8888);
+    config.output.u.RGBA.size = config.output.u.RGBA.stride * dstHeight;
     auto pixels = new (std::nothrow) uint8_t[config.output.u.RGBA.size];
     if (pixels) {
       config.output.u.RGBA.rgba = pixels;
@@ -94,7 +103,7 @@ bool WebpImage::readPixels(const ImageInfo& dstInfo, void* dstPixels) const {
       // convert to ALPHA_8
       if (decodeSuccess) {
         auto info =
-            ImageInfo::Make(width(), height(), ColorType::RGBA_8888, AlphaType::Unpremultiplied);
+            ImageInfo::Make(dstWidth, dstHeight, ColorType::RGBA_8888, AlphaType::Unpremultiplied);
         Bitmap bitmap(info, pixels);
         decodeSuccess = bitmap.readPixels(dstInfo, dstPixels);
       }
@@ -105,7 +114,7 @@ bool WebpImage::readPixels(const ImageInfo& dstInfo, void* dstPixels) const {
         webp_decode_mode(dstInfo.colorType(), dstInfo.alphaType() == AlphaType::Premultiplied);
     config.output.u.RGBA.rgba = reinterpret_cast<uint8_t*>(dstPixels);
     config.output.u.RGBA.stride = static_cast<int>(dstInfo.rowBytes());
-    config.output.u.RGBA.size = dstInfo.rowBytes() * height();
+    config.output.u.RGBA.size = dstInfo.rowBytes() * dstHeight;
     auto code = WebPDecode(byteData->bytes(), byteData->size(), &config);
     decodeSuccess = code == VP8_STATUS_OK;
   }
@@ -113,6 +122,16 @@ bool WebpImage::readPixels(const ImageInfo& dstInfo, void* dstPixels) const {
   return decodeSuccess;
 }
 
+bool WebpImage::getScaledDimensions(float scaleFactor, int* scaledWidth, int* scaledHeight) const {
+  *scaledWidth = static_cast<int>(ceilf(static_cast<float>(width()) * scaleFactor));
+  *scaledHeight = static_cast<int>(ceilf(static_cast<float>(height()) * scaleFactor));
+  return *scaledWidth > 0 && *scaledHeight > 0;
+}
+
+bool WebpImage::readScaledPixels(const ImageInfo& dstInfo, void* dstPixels) const {
+  return readPixels(dstInfo, dstPixels);
+}
+
 #ifdef TGFX_USE_WEBP_ENCODE
 struct WebpWriter {
   unsigned char* data = nullptr;
@@ -38,6 +38,10 @@ class WebpImage : public Image {
  protected:
   bool readPixels(const ImageInfo& dstInfo, void* dstPixels) const override;
 
+  bool getScaledDimensions(float scaleFactor, int* scaledWidth, int* scaledHeight) const override;
+
+  bool readScaledPixels(const ImageInfo& dstInfo, void* dstPixels) const override;
+
  private:
   std::shared_ptr<Data> fileData;
   std::string filePath;
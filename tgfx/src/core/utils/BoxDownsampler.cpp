@@ -0,0 +1,100 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2021 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "BoxDownsampler.h"
+
+namespace tgfx {
+bool BoxDownsampler::Downsample(const ImageInfo& srcInfo, const void* srcPixels,
+                                const ImageInfo& dstInfo, void* dstPixels) {
+  if (srcPixels == nullptr || srcInfo.colorType() != dstInfo.colorType()) {
+    return false;
+  }
+  BoxDownsampler downsampler(srcInfo.width(), srcInfo.height(), dstInfo, dstPixels);
+  if (!downsampler.isValid()) {
+    return false;
+  }
+  auto row = static_cast<const uint8_t*>(srcPixels);
+  for (int y = 0; y < srcInfo.height(); y++) {
+    downsampler.addRow(row);
+    row += srcInfo.rowBytes();
+  }
+  return true;
+}
+
+BoxDownsampler::BoxDownsampler(int srcWidth, int srcHeight, const ImageInfo& dstInfo,
+                               void* dstPixels)
+    : srcHeight(srcHeight), dstInfo(dstInfo), dstPixels(static_cast<uint8_t*>(dstPixels)),
+      bytesPerPixel(ImageInfo::GetBytesPerPixel(dstInfo.colorType())) {
+  if (srcWidth < dstInfo.width() || srcHeight < dstInfo.height() || dstInfo.isEmpty()) {
+    return;
+  }
+  auto dstWidth = dstInfo.width();
+  columnBounds.resize(static_cast<size_t>(dstWidth) + 1);
+  for (int x = 0; x <= dstWidth; x++) {
+    columnBounds[x] = static_cast<int>(static_cast<int64_t>(x) * srcWidth / dstWidth);
+  }
+  sums.resize(static_cast<size_t>(dstWidth) * bytesPerPixel, 0);
+}
+
+bool BoxDownsampler::isValid() const {
+  return dstPixels != nullptr && bytesPerPixel > 0 && !sums.empty();
+}
+
+int BoxDownsampler::rowBound(int y) const {
+  return static_cast<int>(static_cast<int64_t>(y) * srcHeight / dstInfo.height());
+}
+
+void BoxDownsampler::addRow(const void* srcRow) {
+  if (!isValid() || dstY >= dstInfo.height()) {
+    return;
+  }
+  auto src = static_cast<const uint8_t*>(srcRow);
+  auto dstWidth = dstInfo.width();
+  for (int x = 0; x < dstWidth; x++) {
+    auto sum = sums.data() + x * bytesPerPixel;
+    auto pixel = src + columnBounds[x] * bytesPerPixel;
+    auto end = src + columnBounds[x + 1] * bytesPerPixel;
+    for (; pixel < end; pixel += bytesPerPixel) {
+      for (int i = 0; i < bytesPerPixel; i++) {
+        sum[i] += pixel[i];
+      }
+    }
+  }
+  boxRows++;
+  srcY++;
+  if (srcY == rowBound(dstY + 1)) {
+    flushRow();
+  }
+}
+
+void BoxDownsampler::flushRow() {
+  auto dstRow = dstPixels + dstInfo.rowBytes() * dstY;
+  auto dstWidth = dstInfo.width();
+  for (int x = 0; x < dstWidth; x++) {
+    auto count = static_cast<uint64_t>(columnBounds[x + 1] - columnBounds[x]) * boxRows;
+    auto sum = sums.data() + x * bytesPerPixel;
+    auto pixel = dstRow + x * bytesPerPixel;
+    for (int i = 0; i < bytesPerPixel; i++) {
+      pixel[i] = static_cast<uint8_t>((sum[i] + count / 2) / count);
+      sum[i] = 0;
+    }
+  }
+  boxRows = 0;
+  dstY++;
+}
+}  // namespace tgfx
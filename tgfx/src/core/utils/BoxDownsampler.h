@@ -0,0 +1,66 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2021 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <vector>
+#include "tgfx/core/ImageInfo.h"
+
+namespace tgfx {
+/**
+ * BoxDownsampler reduces the resolution of an image by averaging every source pixel that falls
+ * into the area of a destination pixel. The source rows are fed one by one, so the full resolution
+ * image never needs to be kept in memory. The source rows must have the same color type as the
+ * destination, and the averaging is done in the alpha type of the destination.
+ */
+class BoxDownsampler {
+ public:
+  /**
+   * Downsamples the srcPixels to the dimensions of the dstInfo. Returns false if the color types
+   * of the two infos are different or the dstInfo is larger than the srcInfo.
+   */
+  static bool Downsample(const ImageInfo& srcInfo, const void* srcPixels, const ImageInfo& dstInfo,
+                         void* dstPixels);
+
+  BoxDownsampler(int srcWidth, int srcHeight, const ImageInfo& dstInfo, void* dstPixels);
+
+  /**
+   * Returns false if the source dimensions are smaller than the destination ones.
+   */
+  bool isValid() const;
+
+  /**
+   * Accumulates the next source row, which must contain srcWidth pixels.
+   */
+  void addRow(const void* srcRow);
+
+ private:
+  int srcHeight = 0;
+  ImageInfo dstInfo = {};
+  uint8_t* dstPixels = nullptr;
+  int bytesPerPixel = 0;
+  int srcY = 0;
+  int dstY = 0;
+  int boxRows = 0;
+  std::vector<int> columnBounds = {};
+  std::vector<uint64_t> sums = {};
+
+  int rowBound(int y) const;
+  void flushRow();
+};
+}  // namespace tgfx
@@ -0,0 +1,43 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2021 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "AARRectEffect.h"
+#include "core/utils/UniqueID.h"
+#include "opengl/GLAARRectEffect.h"
+
+namespace tgfx {
+// Radii smaller than half a pixel can not be distinguished from square corners by the coverage
+// approximation in the shader.
+static constexpr float MIN_RADIUS = 0.5f;
+
+std::unique_ptr<AARRectEffect> AARRectEffect::Make(const RRect& rRect) {
+  if (rRect.radii.x < MIN_RADIUS || rRect.radii.y < MIN_RADIUS) {
+    return nullptr;
+  }
+  return std::unique_ptr<AARRectEffect>(new AARRectEffect(rRect));
+}
+
+void AARRectEffect::onComputeProcessorKey(BytesKey* bytesKey) const {
+  static auto Type = UniqueID::Next();
+  bytesKey->write(Type);
+}
+
+std::unique_ptr<GLFragmentProcessor> AARRectEffect::onCreateGLInstance() const {
+  return std::make_unique<GLAARRectEffect>();
+}
+}  // namespace tgfx
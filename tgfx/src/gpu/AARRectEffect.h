@@ -0,0 +1,52 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2021 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "FragmentProcessor.h"
+
+namespace tgfx {
+/**
+ * AARRectEffect computes the anti-aliased coverage of a simple round rect or an oval in device
+ * space analytically, which is used to clip draws without rasterizing a clip mask.
+ */
+class AARRectEffect : public FragmentProcessor {
+ public:
+  /**
+   * Creates a new AARRectEffect with a round rect in device space. Returns nullptr if the radii are
+   * too small to be treated as round corners.
+   */
+  static std::unique_ptr<AARRectEffect> Make(const RRect& rRect);
+
+  std::string name() const override {
+    return "AARRectEffect";
+  }
+
+ private:
+  explicit AARRectEffect(const RRect& rRect) : rRect(rRect) {
+  }
+
+  void onComputeProcessorKey(BytesKey* bytesKey) const override;
+
+  std::unique_ptr<GLFragmentProcessor> onCreateGLInstance() const override;
+
+  RRect rRect = {};
+
+  friend class GLAARRectEffect;
+};
+}  // namespace tgfx
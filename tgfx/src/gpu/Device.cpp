@@ -31,8 +31,23 @@ Device::~Device() {
   DEBUG_ASSERT(context == nullptr);
 }
 
-Context* Device::lockContext() {
+void Device::lockInOrder() {
+  {
+    std::unique_lock<std::mutex> autoLock(queueLocker);
+    auto ticket = nextTicket++;
+    queueCondition.wait(autoLock, [&] { return ticket == servingTicket; });
+  }
+  // Only the thread holding the current ticket waits on the locker, the others wait in the queue.
   locker.lock();
+  {
+    std::lock_guard<std::mutex> autoLock(queueLocker);
+    servingTicket++;
+  }
+  queueCondition.notify_all();
+}
+
+Context* Device::lockContext() {
+  lockInOrder();
   contextLocked = onLockContext();
   if (!contextLocked) {
     locker.unlock();
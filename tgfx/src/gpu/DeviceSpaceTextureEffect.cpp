@@ -26,16 +26,34 @@ std::unique_ptr<DeviceSpaceTextureEffect> DeviceSpaceTextureEffect::Make(const T
   if (texture == nullptr) {
     return nullptr;
   }
+  return Make(texture, deviceOrigin, texture->height(), Point::Zero());
+}
+
+std::unique_ptr<DeviceSpaceTextureEffect> DeviceSpaceTextureEffect::Make(const Texture* texture,
+                                                                         ImageOrigin deviceOrigin,
+                                                                         int deviceHeight,
+                                                                         const Point& offset) {
+  if (texture == nullptr) {
+    return nullptr;
+  }
   return std::unique_ptr<DeviceSpaceTextureEffect>(
-      new DeviceSpaceTextureEffect(texture, deviceOrigin));
+      new DeviceSpaceTextureEffect(texture, deviceOrigin, deviceHeight, offset));
 }
 
-DeviceSpaceTextureEffect::DeviceSpaceTextureEffect(const Texture* texture, ImageOrigin deviceOrigin)
+DeviceSpaceTextureEffect::DeviceSpaceTextureEffect(const Texture* texture, ImageOrigin deviceOrigin,
+                                                   int deviceHeight, const Point& offset)
     : texture(texture) {
   setTextureSamplerCnt(1);
+  // The shader multiplies gl_FragCoord by the reciprocal of the texture size before applying the
+  // matrix, so the offsets here are normalized by the texture size too.
+  auto width = static_cast<float>(texture->width());
+  auto height = static_cast<float>(texture->height());
   if (deviceOrigin == ImageOrigin::BottomLeft) {
     deviceCoordMatrix.postScale(1, -1);
-    deviceCoordMatrix.postTranslate(0, 1);
+    deviceCoordMatrix.postTranslate(-offset.x / width,
+                                    (static_cast<float>(deviceHeight) - offset.y) / height);
+  } else {
+    deviceCoordMatrix.postTranslate(-offset.x / width, -offset.y / height);
   }
   auto scale = texture->getTextureCoord(static_cast<float>(texture->width()),
                                         static_cast<float>(texture->height()));
@@ -26,12 +26,22 @@ class DeviceSpaceTextureEffect : public FragmentProcessor {
   static std::unique_ptr<DeviceSpaceTextureEffect> Make(const Texture* texture,
                                                         ImageOrigin deviceOrigin);
 
+  /**
+   * Creates a DeviceSpaceTextureEffect with a texture which only covers part of the device. The
+   * offset is the top-left position of the texture in device space, and deviceHeight is the height
+   * of the device, which is required to flip the coordinates if deviceOrigin is BottomLeft.
+   */
+  static std::unique_ptr<DeviceSpaceTextureEffect> Make(const Texture* texture,
+                                                        ImageOrigin deviceOrigin, int deviceHeight,
+                                                        const Point& offset);
+
   std::string name() const override {
     return "DeviceSpaceTextureEffect";
   }
 
  private:
-  DeviceSpaceTextureEffect(const Texture* texture, ImageOrigin deviceOrigin);
+  DeviceSpaceTextureEffect(const Texture* texture, ImageOrigin deviceOrigin, int deviceHeight,
+                           const Point& offset);
 
   void onComputeProcessorKey(BytesKey* bytesKey) const override;
 
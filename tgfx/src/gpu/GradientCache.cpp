@@ -18,42 +18,44 @@
 
 #include "GradientCache.h"
 
-#include <utility>
+#include <cstring>
+#include "gpu/opengl/GLContext.h"
+#include "tgfx/gpu/opengl/GLTexture.h"
 
 namespace tgfx {
-// Each bitmap will be 256x1.
-static constexpr size_t kMaxNumCachedGradientBitmaps = 32;
+// Each gradient takes one 256x1 row of the atlas.
+static constexpr int kMaxNumCachedGradientBitmaps = 32;
 static constexpr int kGradientTextureSize = 256;
 
-const Texture* GradientCache::find(const BytesKey& bytesKey) {
-  auto iter = textures.find(bytesKey);
-  if (iter == textures.end()) {
-    return nullptr;
+int GradientCache::find(const BytesKey& bytesKey) {
+  auto iter = rows.find(bytesKey);
+  if (iter == rows.end()) {
+    return -1;
   }
   keys.remove(bytesKey);
   keys.push_front(bytesKey);
-  return iter->second.get();
+  return iter->second;
 }
 
-void GradientCache::add(const BytesKey& bytesKey, std::shared_ptr<Texture> texture) {
-  textures[bytesKey] = std::move(texture);
-  keys.push_front(bytesKey);
-  while (keys.size() > kMaxNumCachedGradientBitmaps) {
+int GradientCache::add(const BytesKey& bytesKey) {
+  int row = static_cast<int>(rows.size());
+  if (row >= kMaxNumCachedGradientBitmaps) {
+    // Reuses the row of the least recently used gradient, so that animated gradients only upload
+    // one row per frame instead of creating new textures.
     auto key = keys.back();
     keys.pop_back();
-    textures.erase(key);
+    auto iter = rows.find(key);
+    row = iter->second;
+    rows.erase(iter);
   }
+  rows[bytesKey] = row;
+  keys.push_front(bytesKey);
+  return row;
 }
 
-std::shared_ptr<PixelBuffer> CreateGradient(const Color* colors, const float* positions, int count,
-                                            int resolution) {
-  auto pixelBuffer = PixelBuffer::Make(resolution, 1, false, false);
-  Bitmap bitmap(pixelBuffer);
-  if (bitmap.isEmpty()) {
-    return nullptr;
-  }
-  bitmap.eraseAll();
-  auto* pixels = reinterpret_cast<uint8_t*>(bitmap.writablePixels());
+static void CreateGradient(const Color* colors, const float* positions, int count, int resolution,
+                           uint8_t* pixels) {
+  memset(pixels, 0, static_cast<size_t>(resolution) * 4);
   int prevIndex = 0;
   for (int i = 1; i < count; ++i) {
     int nextIndex =
@@ -88,10 +90,22 @@ std::shared_ptr<PixelBuffer> CreateGradient(const Color* colors, const float* po
     }
     prevIndex = nextIndex;
   }
-  return pixelBuffer;
 }
 
-const Texture* GradientCache::getGradient(const Color* colors, const float* positions, int count) {
+static void UploadGradientRow(Context* context, const Texture* atlas, int row,
+                              const uint8_t* pixels) {
+  const auto& sampler = static_cast<const GLTexture*>(atlas)->glSampler();
+  auto gl = GLFunctions::Get(context);
+  auto caps = GLCaps::Get(context);
+  const auto& format = caps->getTextureFormat(sampler.format);
+  gl->bindTexture(sampler.target, sampler.id);
+  gl->pixelStorei(GL_UNPACK_ALIGNMENT, 4);
+  gl->texSubImage2D(sampler.target, 0, 0, row, kGradientTextureSize, 1, format.externalFormat,
+                    GL_UNSIGNED_BYTE, pixels);
+}
+
+const Texture* GradientCache::getGradient(const Color* colors, const float* positions, int count,
+                                          float* yCoordinate) {
   BytesKey bytesKey = {};
   for (int i = 0; i < count; ++i) {
     bytesKey.write(colors[i].red);
@@ -100,28 +114,31 @@ const Texture* GradientCache::getGradient(const Color* colors, const float* posi
     bytesKey.write(colors[i].alpha);
     bytesKey.write(positions[i]);
   }
-
-  const auto* texture = find(bytesKey);
-  if (texture) {
-    return texture;
-  }
-  auto pixelBuffer = CreateGradient(colors, positions, count, kGradientTextureSize);
-  if (pixelBuffer == nullptr) {
-    return nullptr;
+  if (atlas == nullptr) {
+    atlas = Texture::MakeRGBA(context, kGradientTextureSize, kMaxNumCachedGradientBitmaps);
+    if (atlas == nullptr) {
+      return nullptr;
+    }
   }
-  auto tex = pixelBuffer->makeTexture(context);
-  if (tex) {
-    add(bytesKey, tex);
+  auto row = find(bytesKey);
+  if (row < 0) {
+    row = add(bytesKey);
+    uint8_t pixels[kGradientTextureSize * 4];
+    CreateGradient(colors, positions, count, kGradientTextureSize, pixels);
+    UploadGradientRow(context, atlas.get(), row, pixels);
   }
-  return tex.get();
+  *yCoordinate =
+      (static_cast<float>(row) + 0.5f) / static_cast<float>(kMaxNumCachedGradientBitmaps);
+  return atlas.get();
 }
 
 void GradientCache::releaseAll() {
-  textures.clear();
+  atlas = nullptr;
+  rows.clear();
   keys.clear();
 }
 
 bool GradientCache::empty() const {
-  return textures.empty() && keys.empty();
+  return atlas == nullptr && rows.empty() && keys.empty();
 }
 }  // namespace tgfx
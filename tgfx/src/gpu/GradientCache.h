@@ -24,6 +24,7 @@
 #include "tgfx/core/Bitmap.h"
 #include "tgfx/core/BytesKey.h"
 #include "tgfx/core/Color.h"
+#include "tgfx/gpu/Texture.h"
 
 namespace tgfx {
 class Context;
@@ -33,19 +34,26 @@ class GradientCache {
   explicit GradientCache(Context* context) : context(context) {
   }
 
-  const Texture* getGradient(const Color* colors, const float* positions, int count);
+  /**
+   * Returns the atlas texture that contains the specified gradient. Each gradient is stored as a
+   * single row of the atlas, and the texture y coordinate at the center of that row is returned in
+   * yCoordinate. Returns nullptr if the atlas can not be created.
+   */
+  const Texture* getGradient(const Color* colors, const float* positions, int count,
+                             float* yCoordinate);
 
   void releaseAll();
 
   bool empty() const;
 
  private:
-  const Texture* find(const BytesKey& bytesKey);
+  int find(const BytesKey& bytesKey);
 
-  void add(const BytesKey& bytesKey, std::shared_ptr<Texture> texture);
+  int add(const BytesKey& bytesKey);
 
   Context* context = nullptr;
+  std::shared_ptr<Texture> atlas = nullptr;
   std::list<BytesKey> keys = {};
-  std::unordered_map<BytesKey, std::shared_ptr<Texture>, BytesHasher> textures = {};
+  std::unordered_map<BytesKey, int, BytesHasher> rows = {};
 };
 }  // namespace tgfx
@@ -103,8 +103,10 @@ static std::unique_ptr<FragmentProcessor> MakeColorizer(const Context* context,
 
   // Otherwise, fall back to a raster gradient sample by a texture, which can handle
   // arbitrary gradients (the only downside being sampling resolution).
-  return TextureGradientColorizer::Make(
-      context->gradientCache()->getGradient(colors + offset, positions + offset, count));
+  float yCoordinate = 0.5f;
+  auto gradient = context->gradientCache()->getGradient(colors + offset, positions + offset, count,
+                                                        &yCoordinate);
+  return TextureGradientColorizer::Make(gradient, yCoordinate);
 }
 
 GradientShaderBase::GradientShaderBase(const std::vector<Color>& colors,
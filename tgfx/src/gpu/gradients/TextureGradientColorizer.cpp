@@ -21,8 +21,13 @@
 #include "gpu/opengl/GLTextureGradientColorizer.h"
 
 namespace tgfx {
-std::unique_ptr<TextureGradientColorizer> TextureGradientColorizer::Make(const Texture* gradient) {
-  return std::unique_ptr<TextureGradientColorizer>(new TextureGradientColorizer(gradient));
+std::unique_ptr<TextureGradientColorizer> TextureGradientColorizer::Make(const Texture* gradient,
+                                                                         float yCoordinate) {
+  if (gradient == nullptr) {
+    return nullptr;
+  }
+  return std::unique_ptr<TextureGradientColorizer>(
+      new TextureGradientColorizer(gradient, yCoordinate));
 }
 
 void TextureGradientColorizer::onComputeProcessorKey(BytesKey* bytesKey) const {
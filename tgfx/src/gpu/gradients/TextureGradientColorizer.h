@@ -25,7 +25,8 @@
 namespace tgfx {
 class TextureGradientColorizer : public FragmentProcessor {
  public:
-  static std::unique_ptr<TextureGradientColorizer> Make(const Texture* gradient);
+  static std::unique_ptr<TextureGradientColorizer> Make(const Texture* gradient,
+                                                        float yCoordinate = 0.5f);
 
   std::string name() const override {
     return "TextureGradientColorizer";
@@ -36,7 +37,8 @@ class TextureGradientColorizer : public FragmentProcessor {
   std::unique_ptr<GLFragmentProcessor> onCreateGLInstance() const override;
 
  private:
-  explicit TextureGradientColorizer(const Texture* gradient) : gradient(gradient) {
+  TextureGradientColorizer(const Texture* gradient, float yCoordinate)
+      : gradient(gradient), yCoordinate(yCoordinate) {
     setTextureSamplerCnt(1);
   }
 
@@ -45,6 +47,7 @@ class TextureGradientColorizer : public FragmentProcessor {
   }
 
   const Texture* gradient;
+  float yCoordinate;
 
   friend class GLTextureGradientColorizer;
 };
@@ -0,0 +1,65 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2021 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "GLAARRectEffect.h"
+#include "gpu/AARRectEffect.h"
+
+namespace tgfx {
+void GLAARRectEffect::emitCode(EmitArgs& args) {
+  auto* fragBuilder = args.fragBuilder;
+  auto* uniformHandler = args.uniformHandler;
+
+  std::string innerRectName;
+  innerRectUniform = uniformHandler->addUniform(ShaderFlags::Fragment, ShaderVar::Type::Float4,
+                                                "InnerRect", &innerRectName);
+  std::string invRadiiSqdName;
+  invRadiiSqdUniform = uniformHandler->addUniform(ShaderFlags::Fragment, ShaderVar::Type::Float2,
+                                                  "InvRadiiSqd", &invRadiiSqdName);
+  // The distances from the fragment to the inner rect, which are zero inside the inner rect and
+  // along the straight edges.
+  fragBuilder->codeAppendf("vec2 dxy0 = %s.xy - gl_FragCoord.xy;", innerRectName.c_str());
+  fragBuilder->codeAppendf("vec2 dxy1 = gl_FragCoord.xy - %s.zw;", innerRectName.c_str());
+  fragBuilder->codeAppend("vec2 dxy = max(max(dxy0, dxy1), 0.0);");
+  // Approximates the distance to the corner ellipse by evaluating its implicit function divided by
+  // the length of the gradient.
+  fragBuilder->codeAppendf("vec2 Z = dxy * %s;", invRadiiSqdName.c_str());
+  fragBuilder->codeAppend("float implicit = dot(Z, dxy) - 1.0;");
+  fragBuilder->codeAppend("float gradDot = max(4.0 * dot(Z, Z), 1.0e-4);");
+  fragBuilder->codeAppend("float approxDist = implicit * inversesqrt(gradDot);");
+  fragBuilder->codeAppend("float coverage = clamp(0.5 - approxDist, 0.0, 1.0);");
+  fragBuilder->codeAppendf("%s = %s * coverage;", args.outputColor.c_str(),
+                           args.inputColor.c_str());
+}
+
+void GLAARRectEffect::onSetData(const ProgramDataManager& programDataManager,
+                                const FragmentProcessor& fragmentProcessor) {
+  const auto& rRectEffect = static_cast<const AARRectEffect&>(fragmentProcessor);
+  const auto& rRect = rRectEffect.rRect;
+  auto innerRect = rRect.rect.makeInset(rRect.radii.x, rRect.radii.y);
+  if (innerRectPrev != innerRect) {
+    innerRectPrev = innerRect;
+    programDataManager.set4f(innerRectUniform, innerRect.left, innerRect.top, innerRect.right,
+                             innerRect.bottom);
+  }
+  if (radiiPrev != rRect.radii) {
+    radiiPrev = rRect.radii;
+    programDataManager.set2f(invRadiiSqdUniform, 1.0f / (rRect.radii.x * rRect.radii.x),
+                             1.0f / (rRect.radii.y * rRect.radii.y));
+  }
+}
+}  // namespace tgfx
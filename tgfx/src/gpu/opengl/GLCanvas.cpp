@@ -17,10 +17,12 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "GLCanvas.h"
+#include <algorithm>
 #include "GLFillRectOp.h"
 #include "GLRRectOp.h"
 #include "GLSurface.h"
 #include "core/utils/MathExtra.h"
+#include "gpu/AARRectEffect.h"
 #include "gpu/AARectEffect.h"
 #include "gpu/ConstColorProcessor.h"
 #include "gpu/DeviceSpaceTextureEffect.h"
@@ -103,25 +105,62 @@ void GLCanvas::clear() {
   renderTarget->clear();
 }
 
-Texture* GLCanvas::getClipTexture() {
-  if (_clipSurface == nullptr) {
-    _clipSurface = Surface::Make(getContext(), surface->width(), surface->height(), true);
-    if (_clipSurface == nullptr) {
-      _clipSurface = Surface::Make(getContext(), surface->width(), surface->height());
+static constexpr size_t MAX_CLIP_MASK_COUNT = 4;
+
+bool GLCanvas::makeClipMask(const Path& clipPath, ClipMask* clipMask) {
+  // Only rasterize the clip within its device bounds. The extra pixel around the bounds keeps the
+  // edge texels transparent, so sampling outside the mask with the clamp wrap mode is clipped out.
+  auto bounds = clipPath.getBounds();
+  bounds.roundOut();
+  bounds.outset(1, 1);
+  if (!bounds.intersect(Rect::MakeWH(surface->width(), surface->height()))) {
+    bounds.setWH(1, 1);
+  }
+  auto width = static_cast<int>(bounds.width());
+  auto height = static_cast<int>(bounds.height());
+  auto maskSurface = Surface::Make(getContext(), width, height, true);
+  if (maskSurface == nullptr) {
+    maskSurface = Surface::Make(getContext(), width, height);
+  }
+  if (maskSurface == nullptr) {
+    return false;
+  }
+  auto maskCanvas = maskSurface->getCanvas();
+  maskCanvas->clear();
+  maskCanvas->setMatrix(Matrix::MakeTrans(-bounds.left, -bounds.top));
+  Paint paint = {};
+  paint.setColor(Color::Black());
+  maskCanvas->drawPath(clipPath, paint);
+  clipMask->path = clipPath;
+  clipMask->bounds = bounds;
+  clipMask->surface = maskSurface;
+  return true;
+}
+
+Texture* GLCanvas::getClipTexture(Rect* maskBounds) {
+  if (clipID != state->clipID || clipMasks.empty()) {
+    const auto& clipPath = state->clip;
+    // Masks of animated layers usually switch between a few clips, reuse the masks of the same clip
+    // path instead of rasterizing them again.
+    auto result = std::find_if(clipMasks.begin(), clipMasks.end(),
+                               [&](const ClipMask& clipMask) { return clipMask.path == clipPath; });
+    if (result != clipMasks.end()) {
+      std::rotate(clipMasks.begin(), result, result + 1);
+    } else {
+      ClipMask clipMask = {};
+      if (!makeClipMask(clipPath, &clipMask)) {
+        return nullptr;
+      }
+      if (clipMasks.size() >= MAX_CLIP_MASK_COUNT) {
+        clipMasks.pop_back();
+      }
+      clipMasks.insert(clipMasks.begin(), std::move(clipMask));
     }
-  }
-  if (_clipSurface == nullptr) {
-    return nullptr;
-  }
-  if (clipID != state->clipID) {
-    auto clipCanvas = _clipSurface->getCanvas();
-    clipCanvas->clear();
-    Paint paint = {};
-    paint.setColor(Color::Black());
-    clipCanvas->drawPath(state->clip, paint);
     clipID = state->clipID;
   }
-  return _clipSurface->getTexture().get();
+  const auto& clipMask = clipMasks.front();
+  *maskBounds = clipMask.bounds;
+  return clipMask.surface->getTexture().get();
 }
 
 static constexpr float BOUNDS_TO_LERANCE = 1e-3f;
@@ -156,10 +195,26 @@ std::unique_ptr<FragmentProcessor> GLCanvas::getClipMask(const Rect& deviceBound
     } else {
       return AARectEffect::Make(rect);
     }
-  } else {
-    return FragmentProcessor::MulInputByChildAlpha(
-        DeviceSpaceTextureEffect::Make(getClipTexture(), surface->origin()));
   }
+  RRect rRect = {};
+  if (clipPath.asRRect(&rRect) && !clipPath.isInverseFillType()) {
+    if (surface->origin() == ImageOrigin::BottomLeft) {
+      auto height = rRect.rect.height();
+      rRect.rect.top = static_cast<float>(surface->height()) - rRect.rect.bottom;
+      rRect.rect.bottom = rRect.rect.top + height;
+    }
+    if (auto effect = AARRectEffect::Make(rRect)) {
+      return effect;
+    }
+  }
+  auto maskBounds = Rect::MakeEmpty();
+  auto maskTexture = getClipTexture(&maskBounds);
+  if (maskTexture == nullptr) {
+    return nullptr;
+  }
+  auto offset = Point::Make(maskBounds.left, maskBounds.top);
+  return FragmentProcessor::MulInputByChildAlpha(
+      DeviceSpaceTextureEffect::Make(maskTexture, surface->origin(), surface->height(), offset));
 }
 
 Rect GLCanvas::clipLocalBounds(Rect localBounds) {
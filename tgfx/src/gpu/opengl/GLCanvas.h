@@ -56,11 +56,23 @@ class GLCanvas : public Canvas {
   }
 
  private:
-  std::shared_ptr<Surface> _clipSurface = nullptr;
+  struct ClipMask {
+    Path path = {};
+    Rect bounds = Rect::MakeEmpty();
+    std::shared_ptr<Surface> surface = nullptr;
+  };
+
+  /**
+   * The recently used clip masks, the first one is the mask of the current clip if clipID matches
+   * the clipID of the current state.
+   */
+  std::vector<ClipMask> clipMasks = {};
   uint32_t clipID = kDefaultClipID;
   GLSurfaceDrawContext* drawContext = nullptr;
 
-  Texture* getClipTexture();
+  Texture* getClipTexture(Rect* maskBounds);
+
+  bool makeClipMask(const Path& clipPath, ClipMask* clipMask);
 
   std::unique_ptr<FragmentProcessor> getClipMask(const Rect& deviceBounds, Rect* scissorRect);
 
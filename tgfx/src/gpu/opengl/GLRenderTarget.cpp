@@ -18,6 +18,7 @@
 
 #include "tgfx/gpu/opengl/GLRenderTarget.h"
 #include "gpu/opengl/GLContext.h"
+#include "core/utils/UniqueID.h"
 #include "gpu/opengl/GLUtil.h"
 #include "tgfx/core/Bitmap.h"
 #include "tgfx/core/Buffer.h"
@@ -138,6 +139,19 @@ static bool CreateRenderBuffer(const GLTexture* texture, GLFrameBuffer* renderTa
 #endif
 }
 
+void GLRenderTarget::ComputeRecycleKey(BytesKey* recycleKey, int width, int height,
+                                       ImageOrigin origin, int sampleCount, PixelFormat format,
+                                       unsigned textureTarget) {
+  static const uint32_t RenderTargetType = UniqueID::Next();
+  recycleKey->write(RenderTargetType);
+  recycleKey->write(static_cast<uint32_t>(width));
+  recycleKey->write(static_cast<uint32_t>(height));
+  recycleKey->write(static_cast<uint32_t>(origin));
+  recycleKey->write(static_cast<uint32_t>(sampleCount));
+  recycleKey->write(static_cast<uint32_t>(format));
+  recycleKey->write(textureTarget);
+}
+
 std::shared_ptr<GLRenderTarget> GLRenderTarget::MakeFrom(const GLTexture* texture,
                                                          int sampleCount) {
   if (texture == nullptr) {
@@ -146,6 +160,18 @@ std::shared_ptr<GLRenderTarget> GLRenderTarget::MakeFrom(const GLTexture* textur
   auto context = texture->getContext();
   auto gl = GLFunctions::Get(context);
   auto caps = GLCaps::Get(context);
+  auto textureInfo = texture->glSampler();
+  BytesKey recycleKey = {};
+  ComputeRecycleKey(&recycleKey, texture->width(), texture->height(), texture->origin(),
+                    sampleCount, textureInfo.format, textureInfo.target);
+  auto recycled =
+      std::static_pointer_cast<GLRenderTarget>(context->resourceCache()->getRecycled(recycleKey));
+  if (recycled) {
+    // 复用帧缓冲对象，只需要把新的纹理重新挂载上去，避免每次都创建新的 FBO 和 RenderBuffer。
+    gl->bindFramebuffer(GL_FRAMEBUFFER, recycled->textureFBInfo.id);
+    FrameBufferTexture2D(context, textureInfo.target, textureInfo.id, sampleCount);
+    return recycled;
+  }
   GLFrameBuffer textureFBInfo = {};
   textureFBInfo.format = texture->glSampler().format;
   gl->genFramebuffers(1, &textureFBInfo.id);
@@ -164,7 +190,6 @@ std::shared_ptr<GLRenderTarget> GLRenderTarget::MakeFrom(const GLTexture* textur
     renderTargetFBInfo = textureFBInfo;
   }
   gl->bindFramebuffer(GL_FRAMEBUFFER, textureFBInfo.id);
-  auto textureInfo = texture->glSampler();
   FrameBufferTexture2D(context, textureInfo.target, textureInfo.id, sampleCount);
 #ifndef TGFX_BUILD_FOR_WEB
   if (gl->checkFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
@@ -305,6 +330,15 @@ void GLRenderTarget::resolve() const {
   }
 }
 
+void GLRenderTarget::computeRecycleKey(BytesKey* recycleKey) const {
+  // 只有挂载了内部纹理的 RenderTarget 才可以复用，外部传入的帧缓冲由调用方管理。
+  if (externalTexture || textureTarget == 0) {
+    return;
+  }
+  ComputeRecycleKey(recycleKey, width(), height(), origin(), sampleCount(), textureFBInfo.format,
+                    textureTarget);
+}
+
 void GLRenderTarget::onReleaseGPU() {
   if (externalTexture) {
     return;
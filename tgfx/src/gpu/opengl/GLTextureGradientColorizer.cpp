@@ -17,13 +17,27 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "GLTextureGradientColorizer.h"
+#include "gpu/gradients/TextureGradientColorizer.h"
 
 namespace tgfx {
 void GLTextureGradientColorizer::emitCode(EmitArgs& args) {
   auto* fragBuilder = args.fragBuilder;
-  fragBuilder->codeAppendf("vec2 coord = vec2(%s.x, 0.5);", args.inputColor.c_str());
+  std::string yCoordinateName;
+  yCoordinateUniform = args.uniformHandler->addUniform(
+      ShaderFlags::Fragment, ShaderVar::Type::Float, "yCoordinate", &yCoordinateName);
+  fragBuilder->codeAppendf("vec2 coord = vec2(%s.x, %s);", args.inputColor.c_str(),
+                           yCoordinateName.c_str());
   fragBuilder->codeAppendf("%s = ", args.outputColor.c_str());
   fragBuilder->appendTextureLookup((*args.textureSamplers)[0], "coord");
   fragBuilder->codeAppend(";");
 }
+
+void GLTextureGradientColorizer::onSetData(const ProgramDataManager& programDataManager,
+                                           const FragmentProcessor& fragmentProcessor) {
+  const auto& fp = static_cast<const TextureGradientColorizer&>(fragmentProcessor);
+  if (yCoordinatePrev != fp.yCoordinate) {
+    yCoordinatePrev = fp.yCoordinate;
+    programDataManager.set1f(yCoordinateUniform, fp.yCoordinate);
+  }
+}
 }  // namespace tgfx
@@ -18,11 +18,19 @@
 
 #pragma once
 
+#include <optional>
 #include "gpu/GLFragmentProcessor.h"
 
 namespace tgfx {
 class GLTextureGradientColorizer : public GLFragmentProcessor {
  public:
   void emitCode(EmitArgs& args) override;
+
+ private:
+  void onSetData(const ProgramDataManager&, const FragmentProcessor&) override;
+
+  UniformHandle yCoordinateUniform;
+
+  std::optional<float> yCoordinatePrev;
 };
 }  // namespace tgfx
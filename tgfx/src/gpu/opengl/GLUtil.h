@@ -47,5 +47,12 @@ bool CheckGLError(Context* context);
 void SubmitGLTexture(Context* context, const GLSampler& sampler, int width, int height,
                      size_t rowBytes, int bytesPerPixel, void* pixels);
 
+/**
+ * Replaces the pixels of an allocated texture in place without reallocating its storage. The width
+ * and height must match the dimensions the texture was allocated with.
+ */
+void UpdateGLTexture(Context* context, const GLSampler& sampler, int width, int height,
+                     size_t rowBytes, int bytesPerPixel, void* pixels);
+
 std::array<float, 9> ToGLMatrix(const Matrix& matrix);
 }  // namespace tgfx
@@ -108,7 +108,7 @@ static std::vector<GLSampler> MakeTexturePlanes(Context* context, const YUVConfi
 }
 
 static void SubmitYUVTexture(Context* context, const YUVConfig& yuvConfig,
-                             const GLSampler yuvTextures[]) {
+                             const GLSampler yuvTextures[], bool allocated) {
   static constexpr int factor[] = {0, 1, 1};
   for (int index = 0; index < yuvConfig.planeCount; index++) {
     const auto& sampler = yuvTextures[index];
@@ -117,7 +117,11 @@ static void SubmitYUVTexture(Context* context, const YUVConfig& yuvConfig,
     auto rowBytes = yuvConfig.rowBytes[index];
     auto bytesPerPixel = yuvConfig.bytesPerPixel[index];
     auto pixels = yuvConfig.pixelsPlane[index];
-    SubmitGLTexture(context, sampler, w, h, rowBytes, bytesPerPixel, pixels);
+    if (allocated) {
+      UpdateGLTexture(context, sampler, w, h, rowBytes, bytesPerPixel, pixels);
+    } else {
+      SubmitGLTexture(context, sampler, w, h, rowBytes, bytesPerPixel, pixels);
+    }
   }
 }
 
@@ -136,6 +140,8 @@ std::shared_ptr<YUVTexture> YUVTexture::MakeI420(Context* context, YUVColorSpace
   GLI420Texture::ComputeRecycleKey(&recycleKey, width, height);
   auto texture =
       std::static_pointer_cast<GLYUVTexture>(context->resourceCache()->getRecycled(recycleKey));
+  // The storage of a recycled texture has been allocated with the same dimensions.
+  auto allocated = texture != nullptr;
   if (texture == nullptr) {
     auto texturePlanes = MakeTexturePlanes(context, yuvConfig);
     if (texturePlanes.empty()) {
@@ -146,7 +152,7 @@ std::shared_ptr<YUVTexture> YUVTexture::MakeI420(Context* context, YUVColorSpace
                                                   yuvConfig.width, yuvConfig.height)));
     texture->samplers = texturePlanes;
   }
-  SubmitYUVTexture(context, yuvConfig, &texture->samplers[0]);
+  SubmitYUVTexture(context, yuvConfig, &texture->samplers[0], allocated);
   return texture;
 }
 
@@ -167,6 +173,8 @@ std::shared_ptr<YUVTexture> YUVTexture::MakeNV12(Context* context, YUVColorSpace
   GLNV12Texture::ComputeRecycleKey(&recycleKey, width, height);
   auto texture =
       std::static_pointer_cast<GLYUVTexture>(context->resourceCache()->getRecycled(recycleKey));
+  // The storage of a recycled texture has been allocated with the same dimensions.
+  auto allocated = texture != nullptr;
   if (texture == nullptr) {
     auto texturePlanes = MakeTexturePlanes(context, yuvConfig);
     if (texturePlanes.empty()) {
@@ -177,10 +185,26 @@ std::shared_ptr<YUVTexture> YUVTexture::MakeNV12(Context* context, YUVColorSpace
                                                   yuvConfig.width, yuvConfig.height)));
     texture->samplers = texturePlanes;
   }
-  SubmitYUVTexture(context, yuvConfig, &texture->samplers[0]);
+  SubmitYUVTexture(context, yuvConfig, &texture->samplers[0], allocated);
   return texture;
 }
 
+bool YUVTexture::updateI420(uint8_t* pixelsPlane[3], const int lineSize[3]) {
+  if (pixelFormat() != YUVPixelFormat::I420) {
+    return false;
+  }
+  YUVConfig yuvConfig = YUVConfig(colorSpace(), colorRange(), width(), height(), I420_PLANE_COUNT);
+  for (int i = 0; i < 3; i++) {
+    yuvConfig.pixelsPlane[i] = pixelsPlane[i];
+    yuvConfig.rowBytes[i] = lineSize[i];
+    yuvConfig.formats[i] = PixelFormat::GRAY_8;
+    yuvConfig.bytesPerPixel[i] = 1;
+  }
+  auto glTexture = static_cast<GLYUVTexture*>(this);
+  SubmitYUVTexture(getContext(), yuvConfig, &glTexture->samplers[0], true);
+  return true;
+}
+
 GLYUVTexture::GLYUVTexture(YUVColorSpace colorSpace, YUVColorRange colorRange, int width,
                            int height)
     : YUVTexture(colorSpace, colorRange, width, height) {
@@ -32,6 +32,12 @@ class NativeImage : public Image {
     return false;
   }
 
+ protected:
+  bool getScaledDimensions(float, int*, int*) const override {
+    // The pixels of native images can not be read back on the web platform.
+    return false;
+  }
+
  private:
   emscripten::val nativeImage = emscripten::val::null();
 